@@ -0,0 +1,127 @@
+//
+// HAC/65 6502 Inferencing Disassembler
+//
+// This work is licensed under the MIT License <https://opensource.org/licenses/MIT>
+// Copyright 2018 David Hinson <https://github.com/dhinson919>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Portions of this work are derived from the RSA Data Security, Inc. MD5 Message-Digest Algorithm
+//
+
+#ifndef HAC65_ADDRESSBITMAP_HPP
+#define HAC65_ADDRESSBITMAP_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "common.hpp"
+
+namespace Hac65
+{
+
+// Set of addresses held as one bit per address of the 6502 address space.  Searches for the next member skip a word
+// of 64 addresses at a time.
+class AddressBitmap
+{
+public:
+    static constexpr uint32_t kSize{0x10000};
+
+private:
+    using Word = uint64_t;
+
+    static constexpr uint32_t kWordBits{64};
+
+    std::array<Word, kSize / kWordBits> _words{};
+
+    size_t _count{0};
+
+public:
+    void
+    Clear ()
+    {
+        _words.fill(0);
+        _count = 0;
+    }
+
+    bool
+    Contains (const Address &address) const
+    {
+        return (_words[address / kWordBits] >> (address % kWordBits)) & 1;
+    }
+
+    // Finds the first member at or after address, returning kSize if none:
+    uint32_t
+    FindNext (uint32_t address) const
+    {
+        if (address >= kSize)
+            return kSize;
+
+        uint32_t index{address / kWordBits};
+        Word word{_words[index] & (~Word{0} << (address % kWordBits))};
+        while (word == 0)
+        {
+            if (++index == _words.size())
+                return kSize;
+            word = _words[index];
+        }
+        return index * kWordBits + static_cast<uint32_t>(__builtin_ctzll(word));
+    }
+
+    // Keeps only the members also in other, a word at a time:
+    void
+    Intersect (const AddressBitmap &other)
+    {
+        _count = 0;
+        for (size_t index{0}; index < _words.size(); ++index)
+        {
+            _words[index] &= other._words[index];
+            _count += static_cast<size_t>(__builtin_popcountll(_words[index]));
+        }
+    }
+
+    bool
+    Insert (const Address &address)
+    {
+        Word &word{_words[address / kWordBits]};
+        const Word mask{Word{1} << (address % kWordBits)};
+        if ((word & mask) != 0)
+            return false;
+        word |= mask;
+        ++_count;
+        return true;
+    }
+
+    // Adds the members of other, a word at a time:
+    void
+    Unite (const AddressBitmap &other)
+    {
+        _count = 0;
+        for (size_t index{0}; index < _words.size(); ++index)
+        {
+            _words[index] |= other._words[index];
+            _count += static_cast<size_t>(__builtin_popcountll(_words[index]));
+        }
+    }
+
+    size_t
+    size () const
+    {
+        return _count;
+    }
+};
+
+}
+
+#endif //HAC65_ADDRESSBITMAP_HPP
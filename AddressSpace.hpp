@@ -0,0 +1,467 @@
+//
+// HAC/65 6502 Inferencing Disassembler
+//
+// This work is licensed under the MIT License <https://opensource.org/licenses/MIT>
+// Copyright 2018 David Hinson <https://github.com/dhinson919>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Portions of this work are derived from the RSA Data Security, Inc. MD5 Message-Digest Algorithm
+//
+
+#ifndef HAC65_ADDRESSSPACE_HPP
+#define HAC65_ADDRESSSPACE_HPP
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "DecodeTable.hpp"
+#include "common.hpp"
+
+namespace Hac65
+{
+
+// Dense, address-indexed analysis results covering the whole 6502 address space.  Each address holds a kind byte, the
+// object's octet and the id of the segment that starts there (0 if none).  Instructions are decoded from the octets
+// when accessed.  Kinds are flags since an
+// address may, for instance, be decoded as an instruction and later be claimed by a data segment.  Segment start
+// addresses are also kept sorted so neighbouring segments are found by binary search.
+class AddressSpace
+{
+public:
+    static constexpr size_t kSize{0x10000};
+
+    enum Kind : Octet
+    {
+        AK__Unknown = 0,
+        AK_Data = 0x01,
+        AK_Illegal = 0x02,
+        AK_Instruction = 0x04
+    };
+
+private:
+    std::array<Octet, kSize> _kinds{};
+
+    // Guard octets past the end let operands be fetched at any address:
+    std::array<Octet, kSize + sizeof(Operand)> _octets{};
+
+    std::array<uint16_t, kSize> _segmentIds{};
+
+    std::array<size_t, AK_Instruction + 1> _kindCounts{};
+
+    std::vector<Segment> _segments;
+
+    // Ids of the slots of _segments left by removed segments, for reuse before the vector grows:
+    std::vector<uint16_t> _freeSegmentIds;
+
+    std::vector<Address> _segmentStarts;
+
+    void
+    ClearKind (const Address &address, Kind kind)
+    {
+        if (HasKind(address, kind))
+        {
+            --_kindCounts[kind];
+            _kinds[address] &= ~kind;
+        }
+    }
+
+    void
+    SetKind (const Address &address, Kind kind)
+    {
+        if (!HasKind(address, kind))
+        {
+            ++_kindCounts[kind];
+            _kinds[address] |= kind;
+        }
+    }
+
+public:
+    // Empties the space, keeping the segment pool's capacity:
+    void
+    Clear ()
+    {
+        _kinds.fill(0);
+        _octets.fill(0);
+        _kindCounts.fill(0);
+        ClearSegments();
+    }
+
+    void
+    ClearCode (const Address &startAddress, const Address &endAddress)
+    {
+        if (_kindCounts[AK_Illegal] == 0 && _kindCounts[AK_Instruction] == 0)
+            return;
+
+        for (uint32_t address{startAddress}; address <= endAddress; ++address)
+        {
+            auto &kinds{_kinds[address]};
+            _kindCounts[AK_Illegal] -= (kinds & AK_Illegal) != 0;
+            _kindCounts[AK_Instruction] -= (kinds & AK_Instruction) != 0;
+            kinds &= ~(AK_Illegal | AK_Instruction);
+        }
+    }
+
+    bool
+    HasKind (const Address &address, Kind kind) const
+    {
+        return (_kinds[address] & kind) != 0;
+    }
+
+    size_t
+    GetKindCount (Kind kind) const
+    {
+        return _kindCounts[kind];
+    }
+
+    Instruction
+    GetInstruction (const Address &address) const
+    {
+        static constexpr Operand kOperandMasks[]{0x0000, 0x00FF, 0xFFFF};
+
+        const Opcode &opcode{_octets[address]};
+        const auto operand{static_cast<Operand>(_octets[address + 1] | (_octets[address + 2] << 8))};
+        return {opcode, static_cast<Operand>(operand & kOperandMasks[LookupDecodeEntry(opcode)._operandSize])};
+    }
+
+    Octet
+    GetOctet (const Address &address) const
+    {
+        return _octets[address];
+    }
+
+    void
+    SetData (const Address &address)
+    {
+        SetKind(address, AK_Data);
+    }
+
+    void
+    SetIllegal (const Address &address)
+    {
+        SetKind(address, AK_Illegal);
+    }
+
+    void
+    SetInstruction (const Address &address)
+    {
+        SetKind(address, AK_Instruction);
+    }
+
+    // Places the object's octets at its origin:
+    void
+    SetOctets (const Address &originAddress, const Octet *pOctets, size_t octetCount)
+    {
+        std::copy(pOctets, pOctets + octetCount, _octets.begin() + originAddress);
+    }
+
+    // Segments are keyed by start address; adding one at an occupied start address replaces it.  Ordinals count the
+    // segments present once the addition is made.
+    void
+    AddSegment (const Address &startAddress, const Segment &segment)
+    {
+        auto &segmentId{_segmentIds[startAddress]};
+        if (segmentId == 0)
+        {
+            if (_freeSegmentIds.empty())
+            {
+                _segments.emplace_back();
+                segmentId = static_cast<uint16_t>(_segments.size());
+            }
+            else
+            {
+                segmentId = _freeSegmentIds.back();
+                _freeSegmentIds.pop_back();
+            }
+            _segmentStarts.insert(
+                std::upper_bound(_segmentStarts.begin(), _segmentStarts.end(), startAddress),
+                startAddress);
+        }
+        _segments[segmentId - 1] = segment;
+        _segments[segmentId - 1]._ordinal = _segmentStarts.size();
+    }
+
+    void
+    ClearSegments ()
+    {
+        for (const auto &segment: _segments)
+            _segmentIds[segment._startAddress] = 0;
+        _segments.clear();
+        _freeSegmentIds.clear();
+        _segmentStarts.clear();
+    }
+
+    // Finds the segment starting at address, if any:
+    Segment *
+    FindSegment (const Address &address)
+    {
+        const auto segmentId{_segmentIds[address]};
+        return (segmentId == 0) ? nullptr : &_segments[segmentId - 1];
+    }
+
+    const Segment *
+    FindSegment (const Address &address) const
+    {
+        return const_cast<AddressSpace *>(this)->FindSegment(address);
+    }
+
+    // Finds the first segment starting at or after address, if any:
+    Segment *
+    FindNextSegment (uint32_t address)
+    {
+        auto itor{std::lower_bound(
+            _segmentStarts.begin(),
+            _segmentStarts.end(),
+            address,
+            [] (const Address &startAddress, uint32_t value) { return startAddress < value; })};
+        return (itor == _segmentStarts.end()) ? nullptr : FindSegment(*itor);
+    }
+
+    const Segment *
+    FindNextSegment (uint32_t address) const
+    {
+        return const_cast<AddressSpace *>(this)->FindNextSegment(address);
+    }
+
+    // Finds the last segment starting at or before address, i.e. the one owning it, if any:
+    Segment *
+    FindPrevSegment (const Address &address)
+    {
+        auto itor{std::upper_bound(_segmentStarts.begin(), _segmentStarts.end(), address)};
+        return (itor == _segmentStarts.begin()) ? nullptr : FindSegment(*--itor);
+    }
+
+    const Segment *
+    FindPrevSegment (const Address &address) const
+    {
+        return const_cast<AddressSpace *>(this)->FindPrevSegment(address);
+    }
+
+    size_t
+    GetSegmentCount () const
+    {
+        return _segmentStarts.size();
+    }
+
+    void
+    RemoveSegment (const Address &startAddress)
+    {
+        if (_segmentIds[startAddress] != 0)
+        {
+            _freeSegmentIds.push_back(_segmentIds[startAddress]);
+            _segmentIds[startAddress] = 0;
+            _segmentStarts.erase(std::lower_bound(_segmentStarts.begin(), _segmentStarts.end(), startAddress));
+        }
+    }
+};
+
+// Read-only, std::map-like view of the addresses of an AddressSpace holding one kind of value.  The accessor supplies
+// membership, value and count.
+template <typename Value, typename Accessor>
+class AddressSpaceView
+{
+public:
+    using value_type = std::pair<Address, Value>;
+
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = AddressSpaceView::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type *;
+        using reference = const value_type &;
+
+    private:
+        const AddressSpace *_pSpace{nullptr};
+        uint32_t _address{AddressSpace::kSize};
+        mutable value_type _value{};
+
+        void
+        Seek ()
+        {
+            while (_address < AddressSpace::kSize && !Accessor::Has(*_pSpace, static_cast<Address>(_address)))
+                ++_address;
+        }
+
+    public:
+        const_iterator () = default;
+
+        const_iterator (const AddressSpace *pSpace, uint32_t address, bool isSeeking = true) :
+            _pSpace(pSpace), _address(address)
+        {
+            if (isSeeking)
+                Seek();
+        }
+
+        reference
+        operator* () const
+        {
+            const auto address{static_cast<Address>(_address)};
+            _value = {address, Accessor::Get(*_pSpace, address)};
+            return _value;
+        }
+
+        pointer
+        operator-> () const
+        {
+            return &**this;
+        }
+
+        const_iterator &
+        operator++ ()
+        {
+            ++_address;
+            Seek();
+            return *this;
+        }
+
+        const_iterator
+        operator++ (int)
+        {
+            auto result{*this};
+            ++*this;
+            return result;
+        }
+
+        bool
+        operator== (const const_iterator &other) const
+        {
+            return _address == other._address;
+        }
+
+        bool
+        operator!= (const const_iterator &other) const
+        {
+            return _address != other._address;
+        }
+    };
+
+private:
+    const AddressSpace *_pSpace;
+
+public:
+    explicit
+    AddressSpaceView (const AddressSpace &space) : _pSpace(&space)
+    {}
+
+    const_iterator
+    begin () const
+    {
+        return {_pSpace, 0};
+    }
+
+    const_iterator
+    end () const
+    {
+        return {_pSpace, AddressSpace::kSize, false};
+    }
+
+    bool
+    empty () const
+    {
+        return size() == 0;
+    }
+
+    const_iterator
+    find (const Address &address) const
+    {
+        return Accessor::Has(*_pSpace, address) ? const_iterator{_pSpace, address, false} : end();
+    }
+
+    size_t
+    size () const
+    {
+        return Accessor::Count(*_pSpace);
+    }
+};
+
+template <AddressSpace::Kind kKind>
+struct AddressSpaceKindAccessor
+{
+    static bool
+    Has (const AddressSpace &space, const Address &address)
+    {
+        return space.HasKind(address, kKind);
+    }
+
+    static size_t
+    Count (const AddressSpace &space)
+    {
+        return space.GetKindCount(kKind);
+    }
+};
+
+struct AddressSpaceDataAccessor : AddressSpaceKindAccessor<AddressSpace::AK_Data>
+{
+    static Octet
+    Get (const AddressSpace &space, const Address &address)
+    {
+        return space.GetOctet(address);
+    }
+};
+
+struct AddressSpaceIllegalAccessor : AddressSpaceKindAccessor<AddressSpace::AK_Illegal>
+{
+    static Opcode
+    Get (const AddressSpace &space, const Address &address)
+    {
+        return space.GetOctet(address);
+    }
+};
+
+struct AddressSpaceInstructionAccessor : AddressSpaceKindAccessor<AddressSpace::AK_Instruction>
+{
+    static Instruction
+    Get (const AddressSpace &space, const Address &address)
+    {
+        return space.GetInstruction(address);
+    }
+};
+
+struct AddressSpaceSegmentAccessor
+{
+    static bool
+    Has (const AddressSpace &space, const Address &address)
+    {
+        return space.FindSegment(address) != nullptr;
+    }
+
+    static Segment
+    Get (const AddressSpace &space, const Address &address)
+    {
+        return *space.FindSegment(address);
+    }
+
+    static size_t
+    Count (const AddressSpace &space)
+    {
+        return space.GetSegmentCount();
+    }
+};
+
+using DataView = AddressSpaceView<Octet, AddressSpaceDataAccessor>;
+
+using IllegalsView = AddressSpaceView<Opcode, AddressSpaceIllegalAccessor>;
+
+using InstructionsView = AddressSpaceView<Instruction, AddressSpaceInstructionAccessor>;
+
+using SegmentsView = AddressSpaceView<Segment, AddressSpaceSegmentAccessor>;
+
+}
+
+#endif //HAC65_ADDRESSSPACE_HPP
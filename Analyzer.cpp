@@ -20,7 +20,13 @@
 // Portions of this work are derived from the RSA Data Security, Inc. MD5 Message-Digest Algorithm
 //
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <iomanip>
+#include <limits>
+#include <thread>
+#include <tuple>
 
 #include "IHac65.hpp"
 #include "Analyzer.hpp"
@@ -44,143 +50,242 @@ Analyzer::AddressToAssemblyOffset (const Address &address) const
     return result;
 }
 
-void
-Analyzer::AddJumpVectorLedges ()
+Instruction
+Analyzer::DecodeInstruction (const Address &address) const
+{
+    // The assembly is padded with guard octets so operands can be fetched without regard to the object's end:
+    static constexpr Operand kOperandMasks[]{0x0000, 0x00FF, 0xFFFF};
+
+    const Octet *pOctets{_assembly.data() + static_cast<Address>(address - GetOriginAddress())};
+    const Opcode opcode{pOctets[0]};
+    const DecodeEntry &decodeEntry{LookupDecodeEntry(opcode)};
+    return {
+        opcode,
+        static_cast<Operand>((pOctets[1] | (pOctets[2] << 8)) & kOperandMasks[decodeEntry._operandSize])};
+}
+
+template <typename LegalHandler, typename IllegalHandler>
+uint16_t
+Analyzer::WalkInstructions (
+    const Address &startAddress,
+    const Address &endAddress,
+    LegalHandler &&legalHandler,
+    IllegalHandler &&illegalHandler) const
 {
-    for (const auto &pair: _jumpVectorTables)
+    uint16_t illegalCount{0};
+
+    const auto originAddress{GetOriginAddress()};
+    uint16_t startPosition{static_cast<uint16_t>(startAddress - originAddress)};
+    uint16_t endPosition{static_cast<uint16_t>(endAddress - originAddress)};
+    if (endPosition >= _lattice.size())
+        endPosition = static_cast<uint16_t>(_lattice.size() - 1);
+
+    for (uint16_t position{startPosition}; position <= endPosition;)
     {
-        const Address &vectorAddress{pair.first};
-        const uint16_t &vectorCount{pair.second};
-        Address offset{0};
-        for (uint16_t count{0}; count < vectorCount; ++count)
-        {
-            AddLand(vectorAddress + offset, Segment::ST_CodeKnown);
-            AddLeap(vectorAddress + offset + sizeof(Operand));
+        const Address address{static_cast<Address>(originAddress + position)};
+
+        if (address >= kNmiVector)
+            break;
 
-            Address assemblyOffset{AddressToAssemblyOffset(vectorAddress + offset)};
-            offset += (sizeof(Opcode) + sizeof(Operand));
-            if (_assembly[assemblyOffset] != OpcodeInfo::JMP_Absolute)
-                assert(false);
-            Address landAddress{
-                static_cast<Address>((_assembly[assemblyOffset + 2] << 8) | _assembly[assemblyOffset + 1])};
-            AddLand(landAddress, Segment::ST_CodeKnown);
+        const LatticeEntry &latticeEntry{_lattice[position]};
+        if (latticeEntry._flowClass == FC__Unknown)
+        {
+            illegalHandler(address, _assembly[position]);
+            ++illegalCount;
         }
+        else if (legalHandler(address, latticeEntry))
+            break;
+
+        position += latticeEntry._length;
     }
+
+    return illegalCount;
 }
 
 inline void
 Analyzer::AddSegment (const Address &segmentAddress, const Segment &segment)
 {
-    _segments[segmentAddress] = {
-        segment._type,
-        segment._startAddress,
-        segment._endAddress,
-        _segments.size()};
+    _space.AddSegment(segmentAddress, segment);
 
     if (segment.IsData())
+        _space.ClearCode(segment._startAddress, segment._endAddress);
+}
+
+void
+Analyzer::AddTableIndirections ()
+{
+    // Declare the single vectors located by indirect tables' vectors as tables of their own:
+    std::vector<std::pair<Address, TableLayout>> vectors;
+    for (const auto &pair: _tables)
     {
-        auto segmentLength{segment._endAddress - segment._startAddress + 1};
-        for (auto count{0}; count < segmentLength; ++count)
+        const auto &table{pair.second};
+        if (table._layout._role != TableLayout::TR_Indirect)
+            continue;
+        const TableLayout vectorLayout{
+            TableLayout::TR_Vector,
+            sizeof(Address),
+            0,
+            1,
+            false,
+            table._layout._landAdjust};
+        for (uint16_t index{0}; index < table._vectorCount; ++index)
         {
-            const auto address{static_cast<Address>(segment._startAddress + count)};
-            RemoveIllegal(address);
-            RemoveInstruction(address);
+            const Address vectorAddress{ReadTableVector(pair.first, table, index)};
+            if (vectorAddress >= GetOriginAddress())
+                vectors.push_back({vectorAddress, vectorLayout});
         }
     }
+    for (const auto &vector: vectors)
+        DeclareTable(vector.first, 1, vector.second);
 }
 
 void
-Analyzer::AddVectorIndirections ()
+Analyzer::AddTableLedges ()
 {
-    auto ftor{
-        [this] (const Address &tableAddress, const uint16_t &entryCount, uint16_t entrySize,
-            uint16_t vectorOffset, uint16_t landAdjust) -> void
+    // Land on every vector of every table in one pass over them in address order, jump tables also landing on and
+    // leaping from each of their JMP instructions:
+    for (const auto &pair: _tables)
+    {
+        const Address &tableAddress{pair.first};
+        const auto &table{pair.second};
+        switch (table._layout._role)
         {
-            Address offset{0};
-            for (uint16_t count{0}; count < entryCount; ++count)
-            {
-                Address assemblyOffset{AddressToAssemblyOffset(tableAddress + offset)};
-                offset += entrySize;
-                Address vectorAddress{
-                    static_cast<Address>(
-                        ((_assembly[assemblyOffset + vectorOffset + 1] << 8) |
-                         _assembly[assemblyOffset + vectorOffset]))};
-                if (vectorAddress >= GetOriginAddress())
-                    switch (landAdjust)
-                    {
-                        case 0: DeclareNormalVectorTable(vectorAddress, 1); break;
-                        case 1: DeclareMinusOneVectorTable(vectorAddress, 1); break;
-                        default: assert(false);
-                    }
-            }
+            case TableLayout::TR_Indirect:
+                break;
+            case TableLayout::TR_Jump:
+                for (uint16_t index{0}; index < table._vectorCount; ++index)
+                {
+                    const auto entryAddress{static_cast<Address>(tableAddress + index * table._layout._entrySize)};
+                    AddLand(entryAddress, Segment::ST_CodeKnown);
+                    AddLeap(entryAddress + sizeof(Operand));
+                    if (_assembly[AddressToAssemblyOffset(entryAddress)] != OpcodeInfo::JMP_Absolute)
+                        assert(false);
+                    AddLand(ReadTableVector(tableAddress, table, index), Segment::ST_CodeKnown);
+                }
+                break;
+            case TableLayout::TR_Vector:
+                for (uint16_t index{0}; index < table._vectorCount; ++index)
+                    AddLand(
+                        static_cast<Address>(ReadTableVector(tableAddress, table, index) + table._layout._landAdjust),
+                        Segment::ST_CodeKnown);
+                break;
+            default: assert(false);
         }
-    };
-    for (const auto &table: _indirectVectorTables)
-    {
-        const Address &tableAddress{table.first};
-        const uint16_t &entryCount{table.second};
-        ftor(tableAddress, entryCount, sizeof(Address), 0, 0);
-    }
-    for (const auto &table: _keyedIndirectVectorTables)
-    {
-        const Address &tableAddress{table.first};
-        const uint16_t &entryCount{table.second};
-        ftor(tableAddress, entryCount, sizeof(Opcode) + sizeof(Address), 1, 0);
-    }
-    for (const auto &table: _keyedIndirectMinusOneVectorTables)
-    {
-        const Address &tableAddress{table.first};
-        const uint16_t &entryCount{table.second};
-        ftor(tableAddress, entryCount, sizeof(Opcode) + sizeof(Address), 1, 1);
     }
 }
 
 void
-Analyzer::AddVectorLedges ()
+Analyzer::DetectOriginAddress ()
 {
+    // Candidate origins are every page the object fits from, led by the one placing its tail on the machine vectors,
+    // but only those under which every declared vector table lies within the object.  As the builtin architecture
+    // declares the machine vectors, other pages are only candidates when an overlay leaves those out for other lands;
+    // with no candidate left, the tail is taken.  Each scores a point for every absolute JSR or JMP operand in the
+    // object, and for every machine vector when the tail is on them, that lands within the object on a few legal
+    // instructions in a row.  Candidates are scored concurrently in contiguous shards; the first of the best scoring
+    // wins, with a confidence given by how far it leads the runner-up:
+    static constexpr Opcode JSR_Absolute{0x20};
+    static constexpr Opcode JMP_Absolute{0x4C};
+    static constexpr uint32_t kPageSize{0x100};
+    static constexpr uint32_t kLandingInstructionCount{8};
+
+    if (_assemblySize == 0 || _assemblySize > kMaxAssemblySize)
+        throw Hac65Exception("cannot detect the origin address of an object of this size (see -o option)");
+
+    std::vector<Address> targets;
+    for (size_t position{0}; position + sizeof(Opcode) + sizeof(Operand) <= _assemblySize; ++position)
+        if (_assembly[position] == JSR_Absolute || _assembly[position] == JMP_Absolute)
+            targets.push_back(static_cast<Address>(_assembly[position + 1] | (_assembly[position + 2] << 8)));
+
+    // { first address, last address }
+    std::vector<std::pair<uint32_t, uint32_t>> tableExtents;
+    for (const auto &[tableAddress, table]: _tables)
+        if (table._vectorCount != 0)
+            tableExtents.emplace_back(tableAddress, tableAddress + table._layout.GetTableSize(table._vectorCount) - 1);
+    const auto isHoldingTables{
+        [this, &tableExtents] (uint32_t originAddress) -> bool
+        {
+            return std::all_of(
+                std::begin(tableExtents),
+                std::end(tableExtents),
+                [this, originAddress] (const std::pair<uint32_t, uint32_t> &extent) -> bool
+                { return originAddress <= extent.first && extent.second < originAddress + _assemblySize; });
+        }};
+
+    const auto tailAddress{static_cast<uint32_t>(kMaxAssemblySize - _assemblySize)};
+    std::vector<uint32_t> candidates;
+    if (isHoldingTables(tailAddress))
+        candidates.push_back(tailAddress);
+    for (uint32_t originAddress{0}; originAddress <= tailAddress; originAddress += kPageSize)
+        if (originAddress != tailAddress && isHoldingTables(originAddress))
+            candidates.push_back(originAddress);
+    if (candidates.empty())
+        candidates.push_back(tailAddress);
+
+    std::vector<size_t> scores(candidates.size());
+    const size_t shardCount{std::max<size_t>(std::min<size_t>(_jobCount, candidates.size()), 1)};
     auto ftor{
-        [this] (const Address &tableAddress, const uint16_t &entryCount, uint16_t entrySize,
-            uint16_t vectorOffset, uint16_t splitOffset, uint16_t landAdjust) -> void
+        [this, &targets, &candidates, &scores, shardCount, tailAddress] (size_t shard) -> void
         {
-            Address offset{0};
-            for (uint16_t count{0}; count < entryCount; ++count)
+            const size_t firstCandidate{candidates.size() * shard / shardCount};
+            const size_t lastCandidate{candidates.size() * (shard + 1) / shardCount};
+            for (size_t index{firstCandidate}; index < lastCandidate; ++index)
             {
-                Address assemblyOffset{AddressToAssemblyOffset(tableAddress + offset)};
-                offset += entrySize;
-                Address landAddress{
-                    static_cast<Address>(
-                        ((_assembly[assemblyOffset + vectorOffset + splitOffset + 1] << 8) |
-                         _assembly[assemblyOffset + vectorOffset]) +
-                        landAdjust)};
-                if (landAddress >= GetOriginAddress())
-                    AddLand(landAddress, Segment::ST_CodeKnown);
+                const uint32_t originAddress{candidates[index]};
+                const auto isLanding{
+                    [this, originAddress] (uint32_t target) -> bool
+                    {
+                        if (target < originAddress)
+                            return false;
+                        size_t position{target - originAddress};
+                        for (uint32_t count{0}; count < kLandingInstructionCount && position < _assemblySize; ++count)
+                        {
+                            const DecodeEntry &decodeEntry{LookupDecodeEntry(_assembly[position])};
+                            if (!decodeEntry._isLegal)
+                                return false;
+                            if (decodeEntry._flowClass == FC_Jump || decodeEntry._flowClass == FC_Return)
+                                return true;
+                            position += sizeof(Opcode) + decodeEntry._operandSize;
+                        }
+                        return position < _assemblySize;
+                    }};
+                size_t score{0};
+                for (const auto &target: targets)
+                    score += isLanding(target) ? 1 : 0;
+                if (originAddress == tailAddress)
+                    for (uint32_t vectorAddress{kNmiVector}; vectorAddress < kMaxAssemblySize;
+                        vectorAddress += sizeof(Address))
+                        if (vectorAddress + 1 - originAddress < _assemblySize)
+                            score += isLanding(
+                                _assembly[vectorAddress - originAddress] |
+                                (_assembly[vectorAddress + 1 - originAddress] << 8)) ? 1 : 0;
+                scores[index] = score;
             }
+        }};
+
+    std::vector<std::thread> threads;
+    for (size_t shard{1}; shard < shardCount; ++shard)
+        threads.emplace_back(ftor, shard);
+    ftor(0);
+    for (auto &thread: threads)
+        thread.join();
+
+    size_t bestIndex{0};
+    size_t runnerUpScore{0};
+    for (size_t index{1}; index < candidates.size(); ++index)
+        if (scores[index] > scores[bestIndex])
+        {
+            runnerUpScore = scores[bestIndex];
+            bestIndex = index;
         }
-    };
-    for (const auto &table: _normalVectorTables)
-    {
-        const Address &tableAddress{table.first};
-        const uint16_t &entryCount{table.second};
-        ftor(tableAddress, entryCount, sizeof(Address), 0, 0, 0);
-    }
-    for (const auto &table: _minusOneVectorTables)
-    {
-        const Address &tableAddress{table.first};
-        const uint16_t &entryCount{table.second};
-        ftor(tableAddress, entryCount, sizeof(Address), 0, 0, 1);
-    }
-    for (const auto &table: _keyedVectorTables)
-    {
-        const Address &tableAddress{table.first};
-        const uint16_t &entryCount{table.second};
-        ftor(tableAddress, entryCount, sizeof(Opcode) + sizeof(Address), 1, 0, 0);
-    }
-    for (const auto &table: _splitVectorTables)
-    {
-        const Address &tableAddress{table.first};
-        const uint16_t &entryCount{table.second};
-        ftor(tableAddress, entryCount, sizeof(Address) / 2, 0, static_cast<uint16_t>(entryCount - 1), 0);
-    }
+        else
+            runnerUpScore = std::max(runnerUpScore, scores[index]);
+    if (scores[bestIndex] == 0)
+        throw Hac65Exception("could not detect the origin address -- no calls or jumps land within the object"
+                             " (see -o option)");
+
+    _originAddressOpt = static_cast<Address>(candidates[bestIndex]);
+    _originConfidenceOpt = static_cast<uint8_t>(100 * (scores[bestIndex] - runnerUpScore) / scores[bestIndex]);
 }
 
 void
@@ -201,145 +306,274 @@ Analyzer::InitializeAssembly ()
     }
 
     _endAddress = originAddress + static_cast<Address>(_assemblySize - 1);
+    _space.SetOctets(originAddress, _assembly.data(), _assemblySize);
 
     // Collect vector addresses:
+    for (const auto &pair: _tables)
     {
-        auto ftor{
-            [this] (const std::pair<Address, uint16_t> &pair, const uint16_t &vectorSize) -> void
-            {
-                const Address &tableAddress{pair.first};
-                const uint16_t &vectorCount{pair.second};
-                const uint16_t &octetCount{static_cast<uint16_t>(vectorCount * vectorSize)};
-                for (Address offset{0}; offset < octetCount; ++offset)
-                    _allVectorAddresses.insert(tableAddress + offset);
-            }};
-        std::for_each(std::begin(_jumpVectorTables), std::end(_jumpVectorTables),
-            [this, ftor] (const std::pair<Address, uint16_t> &pair)
-            { ftor(pair, 3); });
-        std::for_each(std::begin(_keyedVectorTables), std::end(_keyedVectorTables),
-            [this, ftor] (const std::pair<Address, uint16_t> &pair)
-            { ftor(pair, 3); });
-        std::for_each(std::begin(_keyedIndirectVectorTables), std::end(_keyedIndirectVectorTables),
-            [this, ftor] (const std::pair<Address, uint16_t> &pair)
-            { ftor(pair, 3); });
-        std::for_each(std::begin(_keyedIndirectMinusOneVectorTables), std::end(_keyedIndirectMinusOneVectorTables),
-            [this, ftor] (const std::pair<Address, uint16_t> &pair)
-            { ftor(pair, 3); });
-        std::for_each(std::begin(_splitVectorTables), std::end(_splitVectorTables),
-            [this, ftor] (const std::pair<Address, uint16_t> &pair)
-            { ftor(pair, 2); });
-        std::for_each(std::begin(_minusOneVectorTables), std::end(_minusOneVectorTables),
-            [this, ftor] (const std::pair<Address, uint16_t> &pair)
-            { ftor(pair, 2); });
-        std::for_each(std::begin(_normalVectorTables), std::end(_normalVectorTables),
-            [this, ftor] (const std::pair<Address, uint16_t> &pair)
-            { ftor(pair, 2); });
-        std::for_each(std::begin(_indirectVectorTables), std::end(_indirectVectorTables),
-            [this, ftor] (const std::pair<Address, uint16_t> &pair)
-            { ftor(pair, 2); });
+        const uint32_t octetCount{pair.second._layout.GetTableSize(pair.second._vectorCount)};
+        for (uint32_t offset{0}; offset < octetCount; ++offset)
+            _allVectorAddresses.Insert(pair.first + offset);
+    }
+}
+
+void
+Analyzer::InitializeLattice ()
+{
+    // Decode an instruction at every object offset, once, for all analysis phases to walk:
+    _lattice.resize(_assemblySize);
+    const auto originAddress{GetOriginAddress()};
+    for (size_t position{0}; position < _assemblySize; ++position)
+    {
+        const auto address{static_cast<Address>(originAddress + position)};
+        const Instruction instruction{DecodeInstruction(address)};
+        const DecodeEntry &decodeEntry{LookupDecodeEntry(instruction._opcode)};
+        Address target{instruction._operand};
+        if (decodeEntry._opcodeInfo._addressMode == AM_Relative)
+            target = address + decodeEntry._operandSize + static_cast<uint16_t>(1) +
+                static_cast<int8_t>(instruction._operand);
+        _lattice[position] = {
+            target,
+            static_cast<uint8_t>(sizeof(Opcode) + decodeEntry._operandSize),
+            decodeEntry._flowClass};
     }
 }
 
 void
 Analyzer::InitializeLedges ()
 {
-    AddVectorIndirections();
+    AddTableIndirections();
 
-    AddVectorLedges();
+    AddTableLedges();
+}
 
-    AddJumpVectorLedges();
+bool
+Analyzer::HasPendingLedge (uint32_t startAddress, uint32_t endAddress) const
+{
+    auto itor{std::lower_bound(
+        std::begin(_pendingLedges),
+        std::end(_pendingLedges),
+        startAddress,
+        [] (const Address &address, uint32_t value) { return address < value; })};
+    return itor != std::end(_pendingLedges) && *itor <= endAddress;
 }
 
-void
+std::vector<Address>
 Analyzer::InferSegments ()
 {
-    InitializeSegments();
+    std::vector<Address> changedAddresses;
+
+    std::sort(std::begin(_pendingLedges), std::end(_pendingLedges));
+    _pendingLedges.erase(std::unique(std::begin(_pendingLedges), std::end(_pendingLedges)), std::end(_pendingLedges));
+
+    if (_space.GetSegmentCount() == 0)
+    {
+        // Segment everything:
+        _codeSegments.clear();
+        PairLedges(
+            std::end(_codeSegments),
+            [this, &changedAddresses] (const Segment &segment) -> bool
+            {
+                _codeSegments.insert({segment._startAddress, segment});
+                changedAddresses.push_back(segment._startAddress);
+                return false;
+            });
+        for (const auto &pair: _codeSegments)
+            AddSegment(pair.first, pair.second);
+        InferVectorTableSegments();
+        for (const auto &segment: _vectorTableSegments)
+            AddSegment(segment._startAddress, segment);
+        InferDataSegments(std::nullopt, std::nullopt);
+        _pendingLedges.clear();
+        return changedAddresses;
+    }
 
-    auto landsItor{std::begin(_lands)};
-    assert(landsItor != std::end(_lands));
-    auto leapsItor{std::begin(_leaps)};
-    assert(leapsItor != std::end(_leaps));
+    // Re-pair code segments from the last one unaffected by each new ledge until pairing falls back in step with the
+    // previous result.  The last code segment may owe its shape to running out of lands or leaps, so it never serves
+    // as a resumption point or as proof of being back in step:
+    std::vector<Address> removedAddresses;
+    for (auto pendingItor{std::begin(_pendingLedges)}; pendingItor != std::end(_pendingLedges);)
+    {
+        auto resumeItor{_codeSegments.upper_bound(*pendingItor)};
+        if (resumeItor != std::begin(_codeSegments))
+        {
+            --resumeItor;
+            if (resumeItor->second._endAddress >= *pendingItor)
+                resumeItor = (resumeItor == std::begin(_codeSegments)) ? std::end(_codeSegments) : std::prev(resumeItor);
+        }
+        else
+            resumeItor = std::end(_codeSegments);
+        if (resumeItor != std::end(_codeSegments) && std::next(resumeItor) == std::end(_codeSegments))
+            resumeItor = (resumeItor == std::begin(_codeSegments)) ? std::end(_codeSegments) : std::prev(resumeItor);
 
-    // Infer code segments:
+        std::vector<Segment> pairedSegments;
+        auto stepItor{std::end(_codeSegments)};
+        PairLedges(
+            resumeItor,
+            [this, &pairedSegments, &stepItor] (const Segment &segment) -> bool
+            {
+                auto itor{_codeSegments.find(segment._startAddress)};
+                if (itor != std::end(_codeSegments) &&
+                    itor->second._endAddress == segment._endAddress &&
+                    std::next(itor) != std::end(_codeSegments) &&
+                    !HasPendingLedge(segment._startAddress + 1u, segment._endAddress))
+                {
+                    stepItor = itor;
+                    return true;
+                }
+                pairedSegments.push_back(segment);
+                return false;
+            });
+
+        // Replace the code segments superseded by the re-pairing:
+        auto itor{(resumeItor == std::end(_codeSegments)) ? std::begin(_codeSegments) : std::next(resumeItor)};
+        auto pairedItor{std::begin(pairedSegments)};
+        while (itor != stepItor)
+        {
+            while (pairedItor != std::end(pairedSegments) && pairedItor->_startAddress < itor->first)
+                changedAddresses.push_back((pairedItor++)->_startAddress);
+            if (pairedItor != std::end(pairedSegments) &&
+                pairedItor->_startAddress == itor->first &&
+                pairedItor->_endAddress == itor->second._endAddress)
+                ++pairedItor;
+            else if (pairedItor != std::end(pairedSegments) && pairedItor->_startAddress == itor->first)
+                changedAddresses.push_back((pairedItor++)->_startAddress);
+            else
+                removedAddresses.push_back(itor->first);
+            itor = _codeSegments.erase(itor);
+        }
+        for (; pairedItor != std::end(pairedSegments); ++pairedItor)
+            changedAddresses.push_back(pairedItor->_startAddress);
+        for (const auto &segment: pairedSegments)
+            _codeSegments.insert({segment._startAddress, segment});
+
+        if (stepItor == std::end(_codeSegments))
+            break;
+        const uint32_t steppedAddress{stepItor->second._endAddress};
+        while (pendingItor != std::end(_pendingLedges) && *pendingItor <= steppedAddress)
+            ++pendingItor;
+    }
+    _pendingLedges.clear();
+
+    // Re-pairings may overlap, so a segment changed by one may be removed by the next:
+    std::sort(std::begin(changedAddresses), std::end(changedAddresses));
+    changedAddresses.erase(
+        std::unique(std::begin(changedAddresses), std::end(changedAddresses)),
+        std::end(changedAddresses));
+    changedAddresses.erase(
+        std::remove_if(
+            std::begin(changedAddresses),
+            std::end(changedAddresses),
+            [this] (const Address &address) { return _codeSegments.count(address) == 0; }),
+        std::end(changedAddresses));
+
+    // Apply the changes beneath any vector tables laid over code, then repair the data segments around them:
+    for (const auto &address: removedAddresses)
+        if (!_vectorTableStarts.Contains(address))
+            _space.RemoveSegment(address);
+    for (const auto &address: changedAddresses)
+        if (!_vectorTableStarts.Contains(address))
+            AddSegment(address, _codeSegments.at(address));
+    for (const auto *pAddresses: {&removedAddresses, &changedAddresses})
+        for (const auto &address: *pAddresses)
+            InferDataSegments(FindBaseSegmentAddress(address, false), FindBaseSegmentAddress(address, true));
+
+    return changedAddresses;
+}
+
+template <typename Emitter>
+void
+Analyzer::PairLedges (std::pmr::map<Address, Segment>::const_iterator resumeItor, Emitter &&emitter) const
+{
+    // Each code segment runs from a land to the first leap at or past it.  Lands within the previous code segment are
+    // passed over:
     const auto originAddress{GetOriginAddress()};
     Address startAddress{originAddress};
     Address endAddress{startAddress};
-    while (startAddress <= _endAddress && landsItor != end(_lands) && leapsItor != end(_leaps))
+    uint32_t landLocation{0};
+    uint32_t leapLocation{0};
+    if (resumeItor != std::end(_codeSegments))
+    {
+        startAddress = resumeItor->second._startAddress;
+        endAddress = resumeItor->second._endAddress;
+        landLocation = startAddress + 1u;
+        leapLocation = endAddress + 1u;
+    }
+    landLocation = _lands.FindNext(landLocation);
+    leapLocation = _leaps.FindNext(leapLocation);
+
+    while (startAddress <= _endAddress && landLocation < AddressBitmap::kSize && leapLocation < AddressBitmap::kSize)
     {
         Segment::Type segmentType{Segment::ST__Unknown};
         do
         {
-            segmentType = landsItor->_type;
-            startAddress = landsItor->_address;
-            ++landsItor;
+            startAddress = static_cast<Address>(landLocation);
+            segmentType = static_cast<Segment::Type>(_landTypes[startAddress]);
+            landLocation = _lands.FindNext(landLocation + 1);
         }
         while (
             startAddress != originAddress &&
             startAddress <= endAddress &&
-            landsItor != end(_lands));
+            landLocation < AddressBitmap::kSize);
         do
         {
-            endAddress = *leapsItor++;
+            endAddress = static_cast<Address>(leapLocation);
+            leapLocation = _leaps.FindNext(leapLocation + 1);
         }
         while (
             endAddress < startAddress &&
-            leapsItor != end(_leaps));
+            leapLocation < AddressBitmap::kSize);
 
         if (startAddress <= endAddress && endAddress <= _endAddress)
-            AddSegment(startAddress, {segmentType, startAddress, endAddress});
-    }
-
-    // Segment non-jump vector tables:
-    for (const auto &pair: _normalVectorTables)
-        AddSegment(
-            pair.first,
-            {Segment::ST_DataKnown, pair.first, static_cast<Address>(pair.first + pair.second * sizeof(Address) - 1)});
-    for (const auto &pair: _indirectVectorTables)
-        AddSegment(
-            pair.first,
-            {Segment::ST_DataKnown, pair.first, static_cast<Address>(pair.first + pair.second * sizeof(Address) - 1)});
-    for (const auto &pair: _keyedVectorTables)
-        AddSegment(
-            pair.first,
-            {
-                Segment::ST_DataKnown,
-                pair.first,
-                static_cast<Address>(pair.first + pair.second * (sizeof(Opcode) + sizeof(Address)) - 1)
-            });
-    for (const auto &pair: _keyedIndirectVectorTables)
-        AddSegment(
-            pair.first,
-            {
-                Segment::ST_DataKnown,
-                pair.first,
-                static_cast<Address>(pair.first + pair.second * (sizeof(Opcode) + sizeof(Address)) - 1)
-            });
-    for (const auto &pair: _keyedIndirectMinusOneVectorTables)
-        AddSegment(
-            pair.first,
-            {
-                Segment::ST_DataKnown,
-                pair.first,
-                static_cast<Address>(pair.first + pair.second * (sizeof(Opcode) + sizeof(Address)) - 1)
-            });
-    for (const auto &pair: _minusOneVectorTables)
-        AddSegment(
-            pair.first,
-            {Segment::ST_DataKnown, pair.first, static_cast<Address>(pair.first + pair.second * sizeof(Address) - 1)});
-    for (const auto &pair: _splitVectorTables)
-        AddSegment(
-            pair.first,
-            {Segment::ST_DataKnown, pair.first, static_cast<Address>(pair.first + pair.second * sizeof(Address) - 1)});
-
-    // Infer remaining data segments:
-    startAddress = originAddress;
-    for (const auto &pair: _segments)
-    {
-        const auto &segmentAddress{pair.first};
-        const auto &segment{pair.second};
-        if (startAddress < segmentAddress)
+            if (emitter(Segment{segmentType, startAddress, endAddress}))
+                break;
+    }
+}
+
+void
+Analyzer::InferVectorTableSegments ()
+{
+    _vectorTableSegments.clear();
+    for (const auto &pair: _tables)
+        if (pair.second._layout._role != TableLayout::TR_Jump)
+            _vectorTableSegments.push_back(
+                {
+                    Segment::ST_DataKnown,
+                    pair.first,
+                    static_cast<Address>(pair.first + pair.second._layout.GetTableSize(pair.second._vectorCount) - 1)
+                });
+
+    for (const auto &segment: _vectorTableSegments)
+        _vectorTableStarts.Insert(segment._startAddress);
+}
+
+void
+Analyzer::InferDataSegments (std::optional<Address> lowerAddressOpt, std::optional<Address> upperAddressOpt)
+{
+    // Data segments fill the gaps between code and vector table segments starting after the lower address (or from the
+    // first) through the upper address (or to the object's end).  Drop those found there before filling afresh:
+    const uint32_t firstAddress{lowerAddressOpt ? *lowerAddressOpt + 1u : 0u};
+    const uint32_t lastAddress{upperAddressOpt.value_or(static_cast<Address>(AddressSpace::kSize - 1))};
+    for (auto pSegment{_space.FindNextSegment(firstAddress)};
+        pSegment != nullptr && pSegment->_startAddress <= lastAddress;)
+    {
+        const auto segmentAddress{pSegment->_startAddress};
+        pSegment = _space.FindNextSegment(segmentAddress + 1u);
+        if (!IsBaseSegment(segmentAddress))
+            _space.RemoveSegment(segmentAddress);
+    }
+
+    Address startAddress{
+        lowerAddressOpt ?
+            static_cast<Address>(_space.FindSegment(*lowerAddressOpt)->_endAddress + 1) :
+            GetOriginAddress()};
+    for (auto pSegment{_space.FindNextSegment(firstAddress)};
+        pSegment != nullptr && pSegment->_startAddress <= lastAddress;)
+    {
+        const Segment segment{*pSegment};
+        if (startAddress < segment._startAddress)
         {
-            endAddress = segment._startAddress - static_cast<Address>(1);
+            const Address endAddress{static_cast<Address>(segment._startAddress - 1)};
             if (endAddress <= _endAddress)
             {
                 const auto labelOpt{LookupLabel(startAddress, std::nullopt)};
@@ -348,199 +582,806 @@ Analyzer::InferSegments ()
             }
         }
         startAddress = segment._endAddress + static_cast<Address>(1);
+        pSegment = _space.FindNextSegment(segment._startAddress + 1u);
     }
-    if (startAddress != 0 /* overflow */ && startAddress < _endAddress)
+    if (!upperAddressOpt && startAddress != 0 /* overflow */ && startAddress < _endAddress)
         AddSegment(startAddress, {Segment::ST_DataInferred, startAddress, _endAddress});
 }
 
-bool
-Analyzer::InferLedges1 ()
+std::optional<Address>
+Analyzer::FindBaseSegmentAddress (const Address &address, bool isSeekingNext) const
 {
-    const auto oldLeapsCount{_leaps.size()};
+    // Finds the nearest code or vector table segment starting before or after address:
+    std::optional<Address> resultOpt;
+    uint32_t location{address};
+    while (true)
+    {
+        const Segment *pSegment{nullptr};
+        if (isSeekingNext)
+            pSegment = _space.FindNextSegment(location + 1);
+        else if (location != 0)
+            pSegment = _space.FindPrevSegment(static_cast<Address>(location - 1));
+        if (pSegment == nullptr)
+            break;
+        location = pSegment->_startAddress;
+        if (IsBaseSegment(pSegment->_startAddress))
+        {
+            resultOpt = pSegment->_startAddress;
+            break;
+        }
+    }
+    return resultOpt;
+}
+
+void
+Analyzer::NumberSegments ()
+{
+    // Number segments as if added one at a time: code segments in address order, then vector tables in address
+    // order (a table replacing a segment takes the count so far), then the data segments between them:
+    size_t ordinal{0};
+    for (const auto &pair: _codeSegments)
+    {
+        ++ordinal;
+        if (!_vectorTableStarts.Contains(pair.first))
+            _space.FindSegment(pair.first)->_ordinal = ordinal;
+    }
+    AddressBitmap tableAddresses;
+    for (const auto &segment: _vectorTableSegments)
+    {
+        if (_codeSegments.count(segment._startAddress) == 0 && tableAddresses.Insert(segment._startAddress))
+            ++ordinal;
+        _space.FindSegment(segment._startAddress)->_ordinal = ordinal;
+    }
+    for (auto pSegment{_space.FindNextSegment(0)}; pSegment != nullptr;
+        pSegment = _space.FindNextSegment(pSegment->_startAddress + 1u))
+        if (!IsBaseSegment(pSegment->_startAddress))
+            pSegment->_ordinal = ++ordinal;
+}
+
+void
+Analyzer::DecodeLedges (const LedgeTask &task, bool isStoppingAtLeap, LedgeFinds &finds)
+{
+    // Resume where any prior decoding from this land left off, as the instruction stream it covered cannot change:
+    const Address &landAddress{task._landAddress};
+    const Address resumeAddress{std::max(_landCursors[landAddress], landAddress)};
+    if (resumeAddress > task._endAddress)
+        return;
+    Address cursor{resumeAddress};
 
     auto legalHandler{
-        [this] (const Address &address, const Instruction &instruction) -> bool
+        [this, &cursor, &finds, &landAddress, isStoppingAtLeap] (
+            const Address &address,
+            const LatticeEntry &latticeEntry) -> bool
         {
-            bool result{false};    // instruction leap discovered?
+            bool isLeap{false};
 
-            const AddressMode &addressMode{instruction._opcodeInfo._addressMode};
-            const AddressModeInfo &addressModeInfo{kAddressModeInfos.at(addressMode)};
-            switch (instruction._opcodeInfo._mnemonic)
+            const Address leapAddress{static_cast<Address>(address + latticeEntry._length - 1)};
+            switch (latticeEntry._flowClass)
             {
-                case M_BCC: case M_BCS: case M_BEQ: case M_BNE: case M_BMI: case M_BPL: case M_BVC: case M_BVS:
-                    {
-                        auto offset{static_cast<int8_t>(instruction._operand)};
-                        AddLand(
-                            address + addressModeInfo._operandSize + static_cast<uint16_t>(1) + offset,
-                            Segment::ST_CodeInferred);
-                    }
+                case FC_Branch:
+                    finds._lands.push_back({landAddress, latticeEntry._target});
                     break;
-                case M_BRK:
-                    AddLeap(address);
-                    result = true;
+                case FC_Break:
+                    finds._leaps.push_back(address);
+                    isLeap = true;
                     break;
-                case M_JMP:
-                    AddLeap(address + addressModeInfo._operandSize);
-                    if (addressMode != AM_Indirect)
+                case FC_Jump:
+                    finds._leaps.push_back(leapAddress);
+                    if (LookupOpcodeInfo(_assembly[address - GetOriginAddress()])._addressMode != AM_Indirect)
                     {
-                        AddLand(instruction._operand, Segment::ST_CodeInferred);
+                        finds._lands.push_back({landAddress, latticeEntry._target});
                     }
-                    result = true;
+                    isLeap = true;
                     break;
-                case M_JSR:
-                    AddLand(instruction._operand, Segment::ST_CodeInferred);
+                case FC_Call:
+                    finds._lands.push_back({landAddress, latticeEntry._target});
                     break;
-                case M_RTI:
-                case M_RTS:
-                    AddLeap(address + addressModeInfo._operandSize);
-                    result = true;
+                case FC_Return:
+                    finds._leaps.push_back(leapAddress);
+                    isLeap = true;
                     break;
 
                 default: break;
             }
 
-            return result;
+            ++finds._instructionCount;
+            cursor = address + latticeEntry._length;
+            return isLeap && isStoppingAtLeap;
+        }};
+    auto illegalHandler{
+        [&cursor, &finds] (const Address &address, const Opcode &opcode) -> void
+        {
+            ++finds._instructionCount;
+            cursor = address + static_cast<Address>(sizeof opcode);
         }};
-    auto illegalHandler{std::function<void (const Address &address, const Opcode &opcode)>()};
-    for (const auto &land: _lands)
-        DecodeInstructions(land._address, _endAddress, legalHandler, illegalHandler);
+    WalkInstructions(resumeAddress, task._endAddress, legalHandler, illegalHandler);
 
-    return _leaps.size() > oldLeapsCount;
+    _landCursors[landAddress] = cursor;
+}
+
+std::vector<Analyzer::LedgeFinds>
+Analyzer::DecodeLedges (const std::vector<LedgeTask> &tasks, bool isStoppingAtLeap)
+{
+    // Tasks touch only their own land's cursor, so they are split into contiguous shards decoded concurrently.  Each
+    // shard collects its finds in task order, keeping the merged result independent of the job count:
+    const size_t shardCount{std::max<size_t>(std::min<size_t>(_jobCount, tasks.size()), 1)};
+    std::vector<LedgeFinds> shardFinds(shardCount);
+    auto ftor{
+        [this, &tasks, isStoppingAtLeap, &shardFinds, shardCount] (size_t shard) -> void
+        {
+            const size_t firstTask{tasks.size() * shard / shardCount};
+            const size_t lastTask{tasks.size() * (shard + 1) / shardCount};
+            for (size_t index{firstTask}; index < lastTask; ++index)
+                DecodeLedges(tasks[index], isStoppingAtLeap, shardFinds[shard]);
+        }};
+
+    std::vector<std::thread> threads;
+    for (size_t shard{1}; shard < shardCount; ++shard)
+        threads.emplace_back(ftor, shard);
+    ftor(0);
+    for (auto &thread: threads)
+        thread.join();
+
+    return shardFinds;
 }
 
 bool
-Analyzer::InferLedges2 ()
+Analyzer::InferDispatchTables (const std::vector<LedgeTask> &tasks)
 {
-    const auto oldLandsCount{_lands.size()};
+    // Recognize dispatch through a pushed return address loaded from a vector of target - 1, as in
+    // LDA vector+1[,X|Y] / PHA / LDA vector[,X|Y] / PHA / RTS, and declare the vectors as a minus-one table.  Unless
+    // the loads are indexed the table has a single vector, else it runs for as long as its vectors land on legal
+    // instructions within the object, short of the next land, leap or segment start.  Indexed loads of split octets,
+    // high above low, give a split table as long as the distance between them; high octets below low cannot be laid
+    // out.  Keyed tables, indexed in steps of an entry, are not told apart from others:
+    static constexpr size_t kMaxVectorCount{128};
+    static constexpr Octet PHA{0x48};
+    static constexpr Octet RTS{0x60};
+    static constexpr TableLayout kSplitMinusOneTableLayout{TableLayout::TR_Vector, 1, 0, 0, true, 1};
 
+    const auto originAddress{GetOriginAddress()};
+    const auto readVector{
+        [this, originAddress] (uint32_t lowAddress, uint32_t highAddress) -> Address
+        {
+            return static_cast<Address>(
+                _assembly[lowAddress - originAddress] | (_assembly[highAddress - originAddress] << 8));
+        }};
+    const auto readAddress{
+        [&readVector] (uint32_t address) -> Address
+        {
+            return readVector(address, address + 1);
+        }};
+    const auto isOctetFree{
+        [this, originAddress] (uint32_t address, bool isExtending) -> bool
+        {
+            return originAddress <= address && address <= _endAddress &&
+                !_allVectorAddresses.Contains(static_cast<Address>(address)) &&
+                !_lands.Contains(static_cast<Address>(address)) &&
+                !(isExtending &&
+                    (_leaps.Contains(static_cast<Address>(address)) ||
+                        _space.FindSegment(static_cast<Address>(address)) != nullptr));
+        }};
+    const auto isVectorPlausible{
+        [this, originAddress, &readVector, &isOctetFree] (
+            const Address &tableAddress,
+            uint16_t vectorCount,
+            const TableLayout &layout,
+            uint16_t index) -> bool
+        {
+            const auto offsets{layout.GetVectorOffsets(vectorCount, index)};
+            const uint32_t lowAddress{tableAddress + offsets.first};
+            const uint32_t highAddress{tableAddress + offsets.second};
+            if (!isOctetFree(lowAddress, index != 0) || !isOctetFree(highAddress, index != 0 || layout._isSplit))
+                return false;
+            const uint32_t landAddress{readVector(lowAddress, highAddress) + 1u};
+            return originAddress <= landAddress && landAddress <= _endAddress &&
+                _lattice[landAddress - originAddress]._flowClass != FC__Unknown;
+        }};
+
+    // { table address, vector count, layout }
+    std::vector<std::tuple<Address, uint16_t, TableLayout>> tables;
     auto legalHandler{
-        [this] (const Address &address, const Instruction &instruction) -> bool
+        [this, originAddress, &readAddress, &isVectorPlausible, &tables] (
+            const Address &address,
+            const LatticeEntry &latticeEntry) -> bool
         {
-            const AddressMode &addressMode{instruction._opcodeInfo._addressMode};
-            const AddressModeInfo &addressModeInfo{kAddressModeInfos.at(addressMode)};
-            switch (instruction._opcodeInfo._mnemonic)
+            const Octet *pOctets{&_assembly[address - originAddress]};
+            const OpcodeInfo &opcodeInfo{LookupOpcodeInfo(pOctets[0])};
+            const AddressMode addressMode{opcodeInfo._addressMode};
+            if (opcodeInfo._mnemonic != M_LDA ||
+                (addressMode != AM_Absolute && addressMode != AM_AbsoluteX && addressMode != AM_AbsoluteY) ||
+                static_cast<uint32_t>(address) + 8 > _endAddress ||
+                pOctets[3] != PHA || pOctets[4] != pOctets[0] || pOctets[7] != PHA || pOctets[8] != RTS)
+                return false;
+            const Address vectorAddress{readAddress(address + 5u)};
+            const Address highAddress{readAddress(address + 1u)};
+            if (highAddress == static_cast<Address>(vectorAddress + 1))
             {
-                case M_BCC: case M_BCS: case M_BEQ: case M_BNE: case M_BMI: case M_BPL: case M_BVC: case M_BVS:
-                    {
-                        auto offset{static_cast<int8_t>(instruction._operand)};
-                        AddLand(
-                            address + addressModeInfo._operandSize + static_cast<uint16_t>(1) + offset,
-                            Segment::ST_CodeInferred);
-                    }
+                const uint16_t countLimit{static_cast<uint16_t>((addressMode == AM_Absolute) ? 1 : kMaxVectorCount)};
+                uint16_t vectorCount{0};
+                while (vectorCount < countLimit &&
+                    isVectorPlausible(vectorAddress, countLimit, kMinusOneTableLayout, vectorCount))
+                    ++vectorCount;
+                if (vectorCount != 0)
+                    tables.emplace_back(vectorAddress, vectorCount, kMinusOneTableLayout);
+            }
+            else if (addressMode != AM_Absolute && highAddress > vectorAddress &&
+                static_cast<size_t>(highAddress - vectorAddress) <= kMaxVectorCount)
+            {
+                const auto vectorCount{static_cast<uint16_t>(highAddress - vectorAddress)};
+                uint16_t index{0};
+                while (index < vectorCount &&
+                    isVectorPlausible(vectorAddress, vectorCount, kSplitMinusOneTableLayout, index))
+                    ++index;
+                if (index == vectorCount)
+                    tables.emplace_back(vectorAddress, vectorCount, kSplitMinusOneTableLayout);
+            }
+            return false;
+        }};
+    for (const auto &task: tasks)
+        WalkInstructions(
+            task._landAddress,
+            task._endAddress,
+            legalHandler,
+            [] (const Address &address, const Opcode &opcode) -> void {});
+
+    bool result{false};
+    for (const auto &[tableAddress, vectorCount, layout]: tables)
+    {
+        // A table found twice, or overlapping one just declared, is only declared once:
+        if (_allVectorAddresses.Contains(tableAddress))
+            continue;
+        DeclareTable(tableAddress, vectorCount, layout);
+        for (uint16_t index{0}; index < vectorCount; ++index)
+        {
+            const auto offsets{layout.GetVectorOffsets(vectorCount, index)};
+            const auto lowAddress{static_cast<Address>(tableAddress + offsets.first)};
+            const auto highAddress{static_cast<Address>(tableAddress + offsets.second)};
+            _allVectorAddresses.Insert(lowAddress);
+            _allVectorAddresses.Insert(highAddress);
+            AddLand(readVector(lowAddress, highAddress) + 1, Segment::ST_CodeInferred);
+        }
+        result = true;
+    }
+    return result;
+}
+
+void
+Analyzer::InferVectorConstants (const std::vector<LedgeTask> &tasks)
+{
+    // Propagate constants loaded into registers through straight-line code, forgetting them wherever control may
+    // arrive from elsewhere or a call intervenes.  Where a code segment stores constants into both octets of a vector,
+    // typically in zero page or RAM, with no call between, the pair is remembered as a value the vector may hold.
+    // Indirect jumps through the vector, wherever they are found, then land on each such value within the object:
+    const auto originAddress{GetOriginAddress()};
+    // Register contents, or kUnknownOctet where not known to be constant:
+    constexpr int kUnknownOctet{-1};
+    int aOctet{kUnknownOctet};
+    int xOctet{kUnknownOctet};
+    int yOctet{kUnknownOctet};
+    std::map<Address, Octet> storedOctets;
+    std::vector<Address> jumpVectors;
+
+    // Remembers the vectors whose octets were both stored, then forgets the stores:
+    const auto recordVectorConstants{
+        [this, &storedOctets] () -> void
+        {
+            for (const auto &pair: storedOctets)
+            {
+                auto itor{storedOctets.find(static_cast<Address>(pair.first + 1))};
+                if (itor != std::end(storedOctets))
+                    _vectorConstants.insert({pair.first, static_cast<Address>((itor->second << 8) | pair.second)});
+            }
+            storedOctets.clear();
+        }};
+
+    auto legalHandler{
+        [this, &aOctet, &xOctet, &yOctet, &storedOctets, &jumpVectors, &recordVectorConstants] (
+            const Address &address,
+            const LatticeEntry &latticeEntry) -> bool
+        {
+            if (_lands.Contains(address))
+                aOctet = xOctet = yOctet = kUnknownOctet;
+
+            const Instruction instruction{DecodeInstruction(address)};
+            const OpcodeInfo &opcodeInfo{instruction.GetOpcodeInfo()};
+            const bool isImmediate{opcodeInfo._addressMode == AM_Immediate};
+            const bool isDirect{
+                opcodeInfo._addressMode == AM_Absolute || opcodeInfo._addressMode == AM_ZeroPage};
+            const int immediateOctet{isImmediate ? static_cast<Octet>(instruction._operand) : kUnknownOctet};
+            auto storeOctet{
+                [&storedOctets, &instruction, isDirect] (int octet) -> void
+                {
+                    if (!isDirect)
+                        return;
+                    if (octet != kUnknownOctet)
+                        storedOctets.insert_or_assign(instruction._operand, static_cast<Octet>(octet));
+                    else
+                        storedOctets.erase(instruction._operand);
+                }};
+            auto stepOctet{
+                [] (int &octet, int step) -> void
+                {
+                    if (octet != kUnknownOctet)
+                        octet = static_cast<Octet>(octet + step);
+                }};
+
+            switch (opcodeInfo._mnemonic)
+            {
+                case M_LDA: aOctet = immediateOctet; break;
+                case M_LDX: xOctet = immediateOctet; break;
+                case M_LDY: yOctet = immediateOctet; break;
+                case M_STA: storeOctet(aOctet); break;
+                case M_STX: storeOctet(xOctet); break;
+                case M_STY: storeOctet(yOctet); break;
+                case M_TAX: xOctet = aOctet; break;
+                case M_TAY: yOctet = aOctet; break;
+                case M_TXA: aOctet = xOctet; break;
+                case M_TYA: aOctet = yOctet; break;
+                case M_INX: stepOctet(xOctet, 1); break;
+                case M_INY: stepOctet(yOctet, 1); break;
+                case M_DEX: stepOctet(xOctet, -1); break;
+                case M_DEY: stepOctet(yOctet, -1); break;
+                case M_ADC:
+                case M_AND:
+                case M_EOR:
+                case M_ORA:
+                case M_PLA:
+                case M_SBC:
+                    aOctet = kUnknownOctet;
                     break;
-                case M_BRK:
-                    AddLeap(address);
+                case M_ASL:
+                case M_LSR:
+                case M_ROL:
+                case M_ROR:
+                    if (opcodeInfo._addressMode == AM_Accumulator)
+                        aOctet = kUnknownOctet;
+                    else
+                        storeOctet(kUnknownOctet);
                     break;
-                case M_JMP:
-                    AddLeap(address + addressModeInfo._operandSize);
-                    if (addressMode != AM_Indirect)
-                    {
-                        AddLand(instruction._operand, Segment::ST_CodeInferred);
-                    }
+                case M_DEC:
+                case M_INC:
+                    storeOctet(kUnknownOctet);
                     break;
+                case M_TSX: xOctet = kUnknownOctet; break;
                 case M_JSR:
-                    AddLand(instruction._operand, Segment::ST_CodeInferred);
+                    // The subroutine may change the registers, and any of the octets stored so far:
+                    aOctet = xOctet = yOctet = kUnknownOctet;
+                    recordVectorConstants();
                     break;
-                case M_RTI:
-                case M_RTS:
-                    AddLeap(address + addressModeInfo._operandSize);
+                case M_JMP:
+                    if (opcodeInfo._addressMode == AM_Indirect)
+                        jumpVectors.push_back(instruction._operand);
                     break;
 
                 default: break;
             }
-
             return false;
         }};
-    auto illegalHandler{std::function<void (const Address &address, const Opcode &opcode)>()};
-    for (const auto &pair: _segments)
+    for (const auto &task: tasks)
     {
-        const auto &segment{pair.second};
-        if (segment.IsCode())
-            DecodeInstructions(segment._startAddress, segment._endAddress, legalHandler, illegalHandler);
+        aOctet = xOctet = yOctet = kUnknownOctet;
+        WalkInstructions(
+            task._landAddress,
+            task._endAddress,
+            legalHandler,
+            [&aOctet, &xOctet, &yOctet] (const Address &address, const Opcode &opcode) -> void
+            { aOctet = xOctet = yOctet = kUnknownOctet; });
+        recordVectorConstants();
     }
 
-    return _lands.size() > oldLandsCount;
+    for (const auto &vectorAddress: jumpVectors)
+        _jumpVectors.Insert(vectorAddress);
+    for (const auto &pair: _vectorConstants)
+        if (_jumpVectors.Contains(pair.first) && pair.second >= originAddress && pair.second <= _endAddress)
+            AddLand(pair.second, Segment::ST_CodeInferred);
 }
 
-uint16_t
-Analyzer::DecodeInstructions (
-    const Address &startAddress,
-    const Address &endAddress,
-    const std::function<bool (Address, Instruction)> &legalHandler,
-    const std::function<void (Address, Opcode)> &illegalHandler) const
+const TableLayout &
+Analyzer::LookupCandidateLayout (const TableCandidate::Kind &kind) const
 {
-    uint16_t illegalCount{0};
+    const TableLayout *pResult{&kNormalTableLayout};
+    switch (kind)
+    {
+        case TableCandidate::TK_Keyed: pResult = &kKeyedTableLayout; break;
+        case TableCandidate::TK_MinusOne: pResult = &kMinusOneTableLayout; break;
+        case TableCandidate::TK_Normal: pResult = &kNormalTableLayout; break;
+        case TableCandidate::TK_Split: pResult = &kSplitTableLayout; break;
+        default: assert(false);
+    }
+    return *pResult;
+}
+
+Address
+Analyzer::ReadCandidateTarget (const TableCandidate &candidate, uint16_t index) const
+{
+    const TableLayout &layout{LookupCandidateLayout(candidate._kind)};
+    return static_cast<Address>(
+        ReadTableVector(candidate._address, {candidate._vectorCount, layout}, index) + layout._landAdjust);
+}
+
+Address
+Analyzer::ReadTableVector (const Address &tableAddress, const DeclaredTable &table, uint16_t index) const
+{
+    const auto offsets{table._layout.GetVectorOffsets(table._vectorCount, index)};
+    return static_cast<Address>(
+        _assembly[AddressToAssemblyOffset(static_cast<Address>(tableAddress + offsets.first))] |
+        (_assembly[AddressToAssemblyOffset(static_cast<Address>(tableAddress + offsets.second))] << 8));
+}
+
+std::vector<TableCandidate>
+Analyzer::FindTableCandidates () const
+{
+    // Propose runs of vectors within inferred data segments whose targets start instructions, laid out as any of the
+    // normal, minus-one, keyed or split tables an overlay may declare.  Targets rate best as lands, then as instructions
+    // decoded from code segments, then as legal opcodes in inferred data that only a table may yet reveal as code.
+    // Words are range-checked against the object in bulk, leaving only those within it to be rated.  Where proposals
+    // overlap within a segment the better scoring wins:
+    static constexpr uint16_t kMinVectorCount{3};
+    static constexpr uint16_t kFullScoreVectorCount{8};
+    static constexpr uint16_t kMaxSplitVectorCount{32};
+    static constexpr uint32_t kBestTargetRating{4};
+    static constexpr uint8_t kMinScore{50};
 
     const auto originAddress{GetOriginAddress()};
-    uint16_t startPosition{static_cast<uint16_t>(startAddress - originAddress)};
-    uint16_t endPosition{static_cast<uint16_t>(endAddress - originAddress)};
 
-    for (uint16_t position{startPosition}; position <= endPosition;)
+    AddressBitmap instructionStarts;
+    for (auto pSegment{_space.FindNextSegment(0)}; pSegment != nullptr;
+        pSegment = _space.FindNextSegment(pSegment->_startAddress + 1u))
+        if (pSegment->IsCode())
+            WalkInstructions(
+                pSegment->_startAddress,
+                pSegment->_endAddress,
+                [&instructionStarts] (const Address &address, const LatticeEntry &latticeEntry) -> bool
+                {
+                    instructionStarts.Insert(address);
+                    return false;
+                },
+                [] (const Address &address, const Opcode &opcode) -> void {});
+
+    const auto rateTarget{
+        [this, originAddress, &instructionStarts] (uint32_t target) -> uint32_t
+        {
+            if (target < originAddress || target > _endAddress)
+                return 0;
+            if (_lands.Contains(static_cast<Address>(target)))
+                return kBestTargetRating;
+            if (instructionStarts.Contains(static_cast<Address>(target)))
+                return kBestTargetRating - 1;
+            const Segment *pSegment{_space.FindPrevSegment(static_cast<Address>(target))};
+            return (pSegment != nullptr && pSegment->_type == Segment::ST_DataInferred &&
+                _lattice[target - originAddress]._flowClass != FC__Unknown) ? kBestTargetRating - 2 : 0;
+        }};
+
+    std::vector<TableCandidate> result;
+    std::vector<Octet> inRangeFlags;
+    std::vector<Octet> hitFlags;
+    std::vector<TableCandidate> proposals;
+    std::vector<bool> claimedOffsets;
+    for (auto pSegment{_space.FindNextSegment(originAddress)}; pSegment != nullptr;
+        pSegment = _space.FindNextSegment(pSegment->_startAddress + 1u))
     {
-        const Address address{static_cast<Address>(originAddress + position)};
+        if (pSegment->_type != Segment::ST_DataInferred || pSegment->_endAddress > _endAddress)
+            continue;
+        const Address &startAddress{pSegment->_startAddress};
+        const uint32_t octetCount{pSegment->_endAddress - startAddress + 1u};
+        if (octetCount < kMinVectorCount * sizeof(Address))
+            continue;
 
-        if (address >= kNmiVector)
-            break;
+        // Flag the words formed with their high octets highOffset along: bit 0 if a plausible target, bit 1 if one once
+        // incremented:
+        const auto flagHits{
+            [this, originAddress, &rateTarget, &inRangeFlags, &hitFlags, &startAddress, octetCount] (
+                uint32_t highOffset) -> void
+            {
+                const uint32_t wordCount{octetCount - highOffset};
+                const Octet *pOctets{&_assembly[startAddress - originAddress]};
+                inRangeFlags.resize(wordCount);
+                hitFlags.assign(wordCount, 0);
+                FlagWordsInRange(
+                    pOctets,
+                    wordCount,
+                    highOffset,
+                    static_cast<uint16_t>(std::max<uint32_t>(originAddress, 1) - 1),
+                    _endAddress,
+                    inRangeFlags.data());
+                for (uint32_t offset{0}; offset < wordCount; ++offset)
+                    if (inRangeFlags[offset] != 0)
+                    {
+                        const auto word{static_cast<uint32_t>(pOctets[offset] | (pOctets[offset + highOffset] << 8))};
+                        hitFlags[offset] = static_cast<Octet>(
+                            ((rateTarget(word) != 0) ? 1 : 0) | ((rateTarget(word + 1) != 0) ? 2 : 0));
+                    }
+            }};
+
+        // Propose each run of at least minCount hits among the words every stride octets from firstOffset:
+        const auto proposeRuns{
+            [&hitFlags, &proposals, &startAddress] (
+                TableCandidate::Kind kind,
+                uint32_t firstOffset,
+                uint32_t stride,
+                uint32_t vectorOffset,
+                Octet hitMask,
+                uint32_t minCount)
+            {
+                uint32_t runOffset{firstOffset};
+                uint32_t runCount{0};
+                for (uint32_t offset{firstOffset};; offset += stride)
+                {
+                    if (offset < hitFlags.size() && (hitFlags[offset] & hitMask) != 0)
+                    {
+                        if (runCount++ == 0)
+                            runOffset = offset;
+                    }
+                    else
+                    {
+                        if (runCount >= minCount)
+                            proposals.push_back(
+                                {
+                                    static_cast<Address>(startAddress + runOffset - vectorOffset),
+                                    static_cast<uint16_t>(std::min<uint32_t>(runCount, UINT16_MAX)),
+                                    kind,
+                                    0,
+                                    false
+                                });
+                        runCount = 0;
+                        if (offset >= hitFlags.size())
+                            break;
+                    }
+                }
+            }};
 
-        const Opcode opcode{_assembly[position]};
-        if (kOpcodeInfos.find(opcode) == kOpcodeInfos.end())
+        proposals.clear();
+        flagHits(1);
+        for (uint32_t firstOffset{0}; firstOffset < sizeof(Address); ++firstOffset)
         {
-            if (illegalHandler)
-                illegalHandler(address, opcode);
-            ++illegalCount;
+            proposeRuns(TableCandidate::TK_Normal, firstOffset, sizeof(Address), 0, 1, kMinVectorCount);
+            proposeRuns(TableCandidate::TK_MinusOne, firstOffset, sizeof(Address), 0, 2, kMinVectorCount);
         }
-        else
+        for (uint32_t firstOffset{1}; firstOffset <= sizeof(Opcode) + sizeof(Address); ++firstOffset)
+            proposeRuns(TableCandidate::TK_Keyed, firstOffset, sizeof(Opcode) + sizeof(Address), 1, 1, kMinVectorCount);
+
+        // A split table of n vectors has n low octets followed by n high octets, so each n is checked apart.  Only the
+        // first n words of a run are the table:
+        const auto splitCountLimit{std::min<uint32_t>(kMaxSplitVectorCount, octetCount / sizeof(Address))};
+        for (uint32_t vectorCount{kMinVectorCount}; vectorCount <= splitCountLimit; ++vectorCount)
+        {
+            flagHits(vectorCount);
+            const auto firstProposal{proposals.size()};
+            proposeRuns(TableCandidate::TK_Split, 0, 1, 0, 1, vectorCount);
+            for (auto index{firstProposal}; index < proposals.size(); ++index)
+                proposals[index]._vectorCount = static_cast<uint16_t>(vectorCount);
+        }
+
+        // Score proposals, discarding the poorly scoring and those whose vectors all agree as they are more likely fill:
+        for (auto itor{std::begin(proposals)}; itor != std::end(proposals);)
         {
-            Operand operand{0};
-            const OpcodeInfo &opcodeInfo{kOpcodeInfos.at(opcode)};
-            const AddressMode &addressMode{opcodeInfo._addressMode};
-            const AddressModeInfo &addressModeInfo{kAddressModeInfos.at(addressMode)};
-            switch (addressModeInfo._operandSize)
+            auto &proposal{*itor};
+            const Address firstTarget{ReadCandidateTarget(proposal, 0)};
+            bool isUniform{true};
+            uint32_t rating{0};
+            for (uint16_t index{0}; index < proposal._vectorCount; ++index)
             {
-                case 0: break;
+                const Address target{ReadCandidateTarget(proposal, index)};
+                isUniform = isUniform && target == firstTarget;
+                rating += rateTarget(target);
+            }
+            proposal._score = static_cast<uint8_t>(
+                50 * rating / (kBestTargetRating * proposal._vectorCount) +
+                50 * std::min<uint32_t>(proposal._vectorCount, kFullScoreVectorCount) / kFullScoreVectorCount);
+            if (isUniform || proposal._score < kMinScore)
+                itor = proposals.erase(itor);
+            else
+                ++itor;
+        }
 
-                case 1:
-                    operand = _assembly[position + 1];
-                    break;
+        std::stable_sort(
+            std::begin(proposals),
+            std::end(proposals),
+            [] (const TableCandidate &left, const TableCandidate &right)
+            {
+                return (left._score != right._score) ?
+                    left._score > right._score :
+                    left._vectorCount > right._vectorCount;
+            });
+        claimedOffsets.assign(octetCount, false);
+        for (const auto &proposal: proposals)
+        {
+            const uint32_t firstOffset{static_cast<uint32_t>(proposal._address - startAddress)};
+            const auto entrySize{
+                static_cast<uint32_t>(
+                    (proposal._kind == TableCandidate::TK_Keyed) ? sizeof(Opcode) + sizeof(Address) : sizeof(Address))};
+            const uint32_t lastOffset{firstOffset + proposal._vectorCount * entrySize - 1};
+            if (std::any_of(
+                std::begin(claimedOffsets) + firstOffset,
+                std::begin(claimedOffsets) + lastOffset + 1,
+                [] (bool isClaimed) { return isClaimed; }))
+                continue;
+            std::fill(std::begin(claimedOffsets) + firstOffset, std::begin(claimedOffsets) + lastOffset + 1, true);
+            result.push_back(proposal);
+        }
+    }
 
-                case 2:
-                    operand = _assembly[position + 1];
-                    operand |= (_assembly[position + 2] << 8);
-                    break;
+    std::sort(
+        std::begin(result),
+        std::end(result),
+        [] (const TableCandidate &left, const TableCandidate &right) { return left._address < right._address; });
+    return result;
+}
 
-                default: assert(false);
+bool
+Analyzer::ApplyTableCandidates ()
+{
+    // Declare candidates scoring well enough as vector tables, landing on their vectors as is done for dispatch tables:
+    bool result{false};
+    for (auto candidate: FindTableCandidates())
+    {
+        if (candidate._score < *_tableApplyingScoreOpt)
+            continue;
+        const TableLayout &layout{LookupCandidateLayout(candidate._kind)};
+        DeclareTable(candidate._address, candidate._vectorCount, layout);
+        const uint32_t octetCount{layout.GetTableSize(candidate._vectorCount)};
+        for (uint32_t offset{0}; offset < octetCount; ++offset)
+            _allVectorAddresses.Insert(candidate._address + offset);
+        for (uint16_t index{0}; index < candidate._vectorCount; ++index)
+            AddLand(ReadCandidateTarget(candidate, index), Segment::ST_CodeInferred);
+        candidate._isApplied = true;
+        _tableCandidates.push_back(candidate);
+        result = true;
+    }
+    return result;
+}
+
+void
+Analyzer::InferTableCandidates ()
+{
+    // Add the candidates remaining once inference is done to those applied during it:
+    for (const auto &candidate: FindTableCandidates())
+        _tableCandidates.push_back(candidate);
+    std::stable_sort(
+        std::begin(_tableCandidates),
+        std::end(_tableCandidates),
+        [] (const TableCandidate &left, const TableCandidate &right) { return left._address < right._address; });
+}
+
+bool
+Analyzer::IsBudgetExhausted ()
+{
+    if (_progressCallback)
+    {
+        _progress._landCount = _lands.size();
+        _progress._leapCount = _leaps.size();
+        _progressCallback(_progress);
+    }
+
+    _isPartial =
+        (_budget._roundLimitOpt && _progress._roundCount >= *_budget._roundLimitOpt) ||
+        (_budget._instructionLimitOpt && _progress._instructionCount >= *_budget._instructionLimitOpt) ||
+        (_budget._deadlineOpt && std::chrono::steady_clock::now() >= *_budget._deadlineOpt) ||
+        (_budget._pIsCancelled != nullptr && _budget._pIsCancelled->load());
+    return _isPartial;
+}
+
+void
+Analyzer::InferLedges ()
+{
+    // Budgets are checked as each batch of decoding is merged.  Stopping early still leaves the ledges found so far
+    // segmented:
+    _progress = {};
+    _isPartial = false;
+
+    // Seed leaps by decoding from each land up to its first leap.  A land found this way is decoded too if it lies
+    // ahead of the land it was found from, so lands are decoded in waves, each merged before the next is launched:
+    const auto oldLeapsCount{_leaps.size()};
+    {
+        AddressBitmap visitedLands;
+        std::vector<LedgeTask> tasks;
+        for (auto landLocation{_lands.FindNext(0)}; landLocation < AddressBitmap::kSize;
+            landLocation = _lands.FindNext(landLocation + 1))
+        {
+            visitedLands.Insert(static_cast<Address>(landLocation));
+            tasks.push_back({static_cast<Address>(landLocation), _endAddress});
+        }
+        while (!tasks.empty())
+        {
+            const auto shardFinds{DecodeLedges(tasks, true)};
+            tasks.clear();
+            for (const auto &finds: shardFinds)
+            {
+                for (const auto &address: finds._leaps)
+                    AddLeap(address);
+                for (const auto &pair: finds._lands)
+                {
+                    const auto &landAddress{pair.second};
+                    AddLand(landAddress, Segment::ST_CodeInferred);
+                    if (landAddress > pair.first && _lands.Contains(landAddress) && visitedLands.Insert(landAddress))
+                        tasks.push_back({landAddress, _endAddress});
+                }
+                _progress._instructionCount += finds._instructionCount;
             }
+            std::sort(
+                std::begin(tasks),
+                std::end(tasks),
+                [] (const LedgeTask &left, const LedgeTask &right) { return left._landAddress < right._landAddress; });
 
-            if (legalHandler(address, {opcode, opcodeInfo, operand}))
+            if (!tasks.empty() && IsBudgetExhausted())
                 break;
+        }
+    }
+    if (_leaps.size() == oldLeapsCount)
+        return;
+    if (_isPartial)
+    {
+        InferSegments();
+        return;
+    }
+
+    // Decode each code segment through to its end until no new lands emerge.  Every land keeps a cursor so an
+    // instruction is decoded once no matter how many rounds its segment survives or how often it grows:
+    size_t oldLandsCount{0};
+    bool isResegmenting{false};
+    do
+    {
+        oldLandsCount = _lands.size();
+        std::vector<LedgeTask> tasks;
+        for (const auto &address: InferSegments())
+        {
+            const auto &segment{*_space.FindSegment(address)};
+            if (segment.IsCode())
+                tasks.push_back({segment._startAddress, segment._endAddress});
+        }
+        for (const auto &finds: DecodeLedges(tasks, false))
+        {
+            for (const auto &address: finds._leaps)
+                AddLeap(address);
+            for (const auto &pair: finds._lands)
+                AddLand(pair.second, Segment::ST_CodeInferred);
+            _progress._instructionCount += finds._instructionCount;
+        }
+        ++_progress._roundCount;
+
+        InferVectorConstants(tasks);
+
+        // Vector tables found dispatching from newly decoded code need segmenting afresh:
+        isResegmenting = InferDispatchTables(tasks);
 
-            position += addressModeInfo._operandSize;
+        // Once inference settles, apply any table candidates good enough to declare and carry on from their vectors:
+        if (!isResegmenting && _lands.size() == oldLandsCount && _tableApplyingScoreOpt)
+            isResegmenting = ApplyTableCandidates();
+        // Segments are only discarded when another round is left to lay them out afresh:
+        if (isResegmenting)
+        {
+            if (IsBudgetExhausted())
+                break;
+            InitializeSegments();
         }
-        position += (sizeof opcode);
     }
+    while ((_lands.size() > oldLandsCount || isResegmenting) && !IsBudgetExhausted());
 
-    return illegalCount;
+    // A round cut short leaves its ledges unsegmented:
+    if (_isPartial)
+        InferSegments();
 }
 
 void
 Analyzer::ExtractCode ()
 {
     auto legalHandler{
-        [this] (const Address &address, const Instruction &instruction) -> bool
+        [this] (const Address &address, const LatticeEntry &latticeEntry) -> bool
         {
-            AddInstruction(address, instruction);
+            AddInstruction(address);
             return false;
         }};
     auto illegalHandler{
         [this] (const Address &address, const Opcode &opcode) -> void
         {
-            AddIllegal(address, opcode);
+            AddIllegal(address);
         }};
-    for (const auto pair: _segments)
+    for (const auto &pair: GetSegments())
     {
         const auto &segment{pair.second};
         if (segment.IsCode())
-            DecodeInstructions(segment._startAddress, segment._endAddress, legalHandler, illegalHandler);
+            WalkInstructions(segment._startAddress, segment._endAddress, legalHandler, illegalHandler);
     }
 }
 
@@ -548,104 +1389,627 @@ void
 Analyzer::ExtractData ()
 {
     // Assume illegal instructions occupy data segments only:
-    for (const auto &pair: _illegals)
+    for (const auto &pair: GetIllegals())
     {
-        for (auto itor{std::rbegin(_segments)}; itor != std::rend(_segments); ++itor)
-        {
-            const auto &segmentAddress{itor->first};
-            auto &segment{itor->second};
-            const auto &illegalAddress{pair.first};
-            if (segmentAddress <= illegalAddress)
-            {
-                segment._type = Segment::ST_DataInferred;
-                break;
-            }
-        }
+        const auto &illegalAddress{pair.first};
+        auto pSegment{_space.FindPrevSegment(illegalAddress)};
+        if (pSegment != nullptr)
+            pSegment->_type = Segment::ST_DataInferred;
     }
 
-    for (auto itor{std::begin(_segments)}; itor != std::end(_segments);)
+    for (auto pSegment{_space.FindNextSegment(0)}; pSegment != nullptr;)
     {
-        auto &segment{itor->second};
+        auto &segment{*pSegment};
         if (segment.IsData())
         {
             // Merge adjacent data segments of the same type:
-            auto mergingItor{itor};
-            ++mergingItor;
-            while (mergingItor != end(_segments) && mergingItor->second._type == segment._type)
+            auto pMerging{_space.FindNextSegment(segment._startAddress + 1u)};
+            while (pMerging != nullptr && pMerging->_type == segment._type)
             {
-                segment._endAddress = mergingItor->second._endAddress;
-                mergingItor = _segments.erase(mergingItor);
+                segment._endAddress = pMerging->_endAddress;
+                const auto mergingAddress{pMerging->_startAddress};
+                pMerging = _space.FindNextSegment(mergingAddress + 1u);
+                _space.RemoveSegment(mergingAddress);
             }
 
             // Collect data octets:
             Address address{segment._startAddress};
             do
             {
-                AddData(address, _assembly[address - GetOriginAddress()]);
+                AddData(address);
             }
             while (address++ < segment._endAddress);
 
-            itor = mergingItor;
+            if (segment._type == Segment::ST_DataInferred)
+                _dataProfiles[segment._startAddress] = ProfileOctets(
+                    &_assembly[segment._startAddress - GetOriginAddress()],
+                    segment._endAddress - segment._startAddress + 1u);
+
+            pSegment = pMerging;
         }
         else
-            ++itor;
+            pSegment = _space.FindNextSegment(segment._startAddress + 1u);
     }
 }
 
+uint8_t
+Analyzer::ScoreDarkCode (const Segment &segment, std::vector<Address> &instructionAddresses) const
+{
+    // Sum the log-odds of each instruction's class following the two before it in code rather than data, collecting
+    // the instructions (illegal ones as themselves) along the way, then map the sum onto a confidence out of 100:
+    int32_t logOdds{0};
+    size_t instructionCount{0};
+    OpcodeClass classes[2]{};
+    auto addClass{
+        [&logOdds, &instructionCount, &classes] (OpcodeClass opcodeClass) -> void
+        {
+            switch (instructionCount++)
+            {
+                case 0: logOdds += kUnigramLogOdds[opcodeClass]; break;
+                case 1: logOdds += kBigramLogOdds[classes[1]][opcodeClass]; break;
+                default: logOdds += kTrigramLogOdds[classes[0]][classes[1]][opcodeClass]; break;
+            }
+            classes[0] = classes[1];
+            classes[1] = opcodeClass;
+        }};
+    instructionAddresses.clear();
+    WalkInstructions(
+        segment._startAddress,
+        segment._endAddress,
+        [this, &instructionAddresses, &addClass] (const Address &address, const LatticeEntry &latticeEntry) -> bool
+        {
+            instructionAddresses.push_back(address);
+            addClass(LookupOpcodeClass(_assembly[address - GetOriginAddress()]));
+            return false;
+        },
+        [&instructionAddresses, &addClass] (const Address &address, const Opcode &opcode) -> void
+        {
+            instructionAddresses.push_back(address);
+            addClass(OC_Illegal);
+        });
+
+    // Log-odds are in quarter nats:
+    return static_cast<uint8_t>(std::lround(100.0 / (1.0 + std::exp(-logOdds / 4.0))));
+}
+
 void
 Analyzer::ExtractDarkCode ()
 {
-    auto prevItor{std::begin(_segments)};
-    for (auto itor{prevItor}; itor != std::end(_segments); ++itor)
+    // Inferred data adjoining code is scored for how much its decoding reads like code, in a single pass, and becomes
+    // dark code if confident enough.  Any illegal opcodes among it are kept as such:
+    std::vector<Address> instructionAddresses;
+    const auto pFirstSegment{_space.FindNextSegment(0)};
+    auto pPrevSegment{pFirstSegment};
+    for (auto pSegment{pFirstSegment}; pSegment != nullptr;)
     {
-        bool hasCodePredecessor{(prevItor == std::begin(_segments)) ? true : prevItor->second.IsCode()};
-        auto nextItor{itor};
-        ++nextItor;
-        bool hasCodeSuccessor{(nextItor == std::end(_segments)) ? true : nextItor->second.IsCode()};
-        auto &segment{itor->second};
+        bool hasCodePredecessor{(pPrevSegment == pFirstSegment) ? true : pPrevSegment->IsCode()};
+        auto pNextSegment{_space.FindNextSegment(pSegment->_startAddress + 1u)};
+        bool hasCodeSuccessor{(pNextSegment == nullptr) ? true : pNextSegment->IsCode()};
+        auto &segment{*pSegment};
         if ((segment._type == Segment::ST_DataInferred) &&
             (hasCodePredecessor || hasCodeSuccessor) &&
             (segment._endAddress - segment._startAddress > 1) &&
             !SegmentHasVectors(segment))
         {
-            uint16_t illegalCount{
-                DecodeInstructions(
-                    segment._startAddress,
-                    segment._endAddress,
-                    [] (const Address &address, const Instruction &instruction) -> bool
-                    { return false; },
-                    std::function<void (const Address &address, const Opcode &opcode)>())};
-
-            if (illegalCount == 0)
+            const uint8_t confidence{ScoreDarkCode(segment, instructionAddresses)};
+            _darkCodeConfidences[segment._startAddress] = confidence;
+            if (confidence >= _illuminatingThreshold)
             {
                 segment._type = Segment::ST_CodeDark;
-                DecodeInstructions(
-                    segment._startAddress,
-                    segment._endAddress,
-                    [this] (const Address &address, const Instruction &instruction) -> bool
-                    {
-                        AddInstruction(address, instruction);
-                        return false;
-                    },
-                    [this] (const Address &address, const Opcode &opcode) -> void
-                    {
-                        AddIllegal(address, opcode);
-                    });
+                _dataProfiles.erase(segment._startAddress);
+                for (const auto &address: instructionAddresses)
+                    if (LookupDecodeEntry(_assembly[address - GetOriginAddress()])._isLegal)
+                        AddInstruction(address);
+                    else
+                        AddIllegal(address);
             }
         }
-        prevItor = itor;
+        pPrevSegment = pSegment;
+        pSegment = pNextSegment;
     }
 }
 
+void
+Analyzer::InferCallGraph ()
+{
+    // Subroutines begin at the blocks JSR calls.  A subroutine's body is the blocks reached from its entry other than
+    // by calling, short of other subroutines' entries, which it is taken to call.  Each block is summarized once, and
+    // bodies gather the summaries of their blocks, then those of their callees as the graph is condensed:
+    static constexpr uint32_t kNoSubroutine{std::numeric_limits<uint32_t>::max()};
+
+    const auto blocks{_flowGraph.GetBlocks()};
+    std::vector<uint32_t> blockSubroutines(blocks.size(), kNoSubroutine);
+    for (uint32_t blockIndex{0}; blockIndex < blocks.size(); ++blockIndex)
+        for (const auto &edge: _flowGraph.GetSuccessors(blockIndex))
+            if (edge._kind == FlowEdge::EK_Call)
+                blockSubroutines[edge._blockIndex] = 0;
+    std::vector<uint32_t> entryBlocks;
+    for (uint32_t blockIndex{0}; blockIndex < blocks.size(); ++blockIndex)
+        if (blockSubroutines[blockIndex] != kNoSubroutine)
+        {
+            blockSubroutines[blockIndex] = static_cast<uint32_t>(entryBlocks.size());
+            entryBlocks.push_back(blockIndex);
+        }
+
+    // What each block writes and how it returns, summarized once for all the subroutines reaching it:
+    struct BlockSummary
+    {
+        Octet _writtenRegisters;
+        std::bitset<0x100> _writtenZeroPage;
+        bool _returnsByRti;
+        bool _returnsByRts;
+    };
+    std::vector<BlockSummary> blockSummaries(blocks.size());
+    for (uint32_t blockIndex{0}; blockIndex < blocks.size(); ++blockIndex)
+    {
+        auto &summary{blockSummaries[blockIndex]};
+        WalkInstructions(
+            blocks[blockIndex]._startAddress,
+            blocks[blockIndex]._endAddress,
+            [this, &summary] (const Address &address, const LatticeEntry &latticeEntry) -> bool
+            {
+                const Instruction instruction{DecodeInstruction(address)};
+                const OpcodeInfo &opcodeInfo{instruction.GetOpcodeInfo()};
+                switch (opcodeInfo._mnemonic)
+                {
+                    case M_ADC: case M_AND: case M_EOR: case M_LDA: case M_ORA: case M_PLA: case M_SBC: case M_TXA:
+                    case M_TYA:
+                        summary._writtenRegisters |= Subroutine::R_A;
+                        break;
+                    case M_ASL: case M_LSR: case M_ROL: case M_ROR:
+                        if (opcodeInfo._addressMode == AM_Accumulator)
+                            summary._writtenRegisters |= Subroutine::R_A;
+                        break;
+                    case M_DEX: case M_INX: case M_LDX: case M_TAX: case M_TSX:
+                        summary._writtenRegisters |= Subroutine::R_X;
+                        break;
+                    case M_DEY: case M_INY: case M_LDY: case M_TAY:
+                        summary._writtenRegisters |= Subroutine::R_Y;
+                        break;
+                    case M_TXS:
+                        summary._writtenRegisters |= Subroutine::R_S;
+                        break;
+                    case M_RTI:
+                        summary._returnsByRti = true;
+                        break;
+                    case M_RTS:
+                        summary._returnsByRts = true;
+                        break;
+                    default: break;
+                }
+                // An indirect operand names the pointer, not the cell written through it:
+                if ((opcodeInfo._memoryOperation == MO_Write || opcodeInfo._memoryOperation == MO_Both) &&
+                    opcodeInfo._addressMode != AM_IndirectX && opcodeInfo._addressMode != AM_IndirectY &&
+                    instruction._operand < 0x100)
+                    summary._writtenZeroPage.set(instruction._operand);
+                return false;
+            },
+            [] (const Address &address, const Opcode &opcode) -> void {});
+    }
+
+    std::vector<Subroutine> subroutines;
+    std::vector<std::vector<uint32_t>> callees(entryBlocks.size());
+    std::vector<uint32_t> blockVisitors(blocks.size(), kNoSubroutine);
+    std::vector<uint32_t> pendingBlocks;
+    for (uint32_t subroutineIndex{0}; subroutineIndex < entryBlocks.size(); ++subroutineIndex)
+    {
+        Subroutine subroutine{blocks[entryBlocks[subroutineIndex]]._startAddress};
+        auto &subroutineCallees{callees[subroutineIndex]};
+        pendingBlocks.push_back(entryBlocks[subroutineIndex]);
+        blockVisitors[entryBlocks[subroutineIndex]] = subroutineIndex;
+        while (!pendingBlocks.empty())
+        {
+            const uint32_t blockIndex{pendingBlocks.back()};
+            pendingBlocks.pop_back();
+            const auto &summary{blockSummaries[blockIndex]};
+            subroutine._writtenRegisters |= summary._writtenRegisters;
+            subroutine._writtenZeroPage |= summary._writtenZeroPage;
+            subroutine._returnsByRti = subroutine._returnsByRti || summary._returnsByRti;
+            subroutine._returnsByRts = subroutine._returnsByRts || summary._returnsByRts;
+            for (const auto &edge: _flowGraph.GetSuccessors(blockIndex))
+            {
+                const uint32_t calleeIndex{blockSubroutines[edge._blockIndex]};
+                if (edge._kind == FlowEdge::EK_Call || (calleeIndex != kNoSubroutine && calleeIndex != subroutineIndex))
+                    subroutineCallees.push_back(calleeIndex);
+                else if (blockVisitors[edge._blockIndex] != subroutineIndex)
+                {
+                    blockVisitors[edge._blockIndex] = subroutineIndex;
+                    pendingBlocks.push_back(edge._blockIndex);
+                }
+            }
+        }
+        std::sort(std::begin(subroutineCallees), std::end(subroutineCallees));
+        subroutineCallees.erase(
+            std::unique(std::begin(subroutineCallees), std::end(subroutineCallees)),
+            std::end(subroutineCallees));
+        subroutines.push_back(subroutine);
+    }
+
+    _callGraph.SetSubroutines(std::move(subroutines));
+    for (uint32_t subroutineIndex{0}; subroutineIndex < callees.size(); ++subroutineIndex)
+        for (const auto &calleeIndex: callees[subroutineIndex])
+            _callGraph.AddCallee(subroutineIndex, calleeIndex);
+    _callGraph.Condense();
+}
+
+void
+Analyzer::InferCrossReferences ()
+{
+    // Every instruction with a memory operand or a flow target refers to it, in one pass in address order.  The same
+    // pass marks the addresses read and written, and those holding pointers for indirect operands, low and high octets
+    // both.  A pointer is only ever read, whatever is done with the address it holds:
+    std::vector<std::pair<Address, CrossReference>> pairs;
+    for (const auto &pair: GetInstructions())
+    {
+        const Address &address{pair.first};
+        const Instruction &instruction{pair.second};
+        const DecodeEntry &decodeEntry{LookupDecodeEntry(instruction._opcode)};
+        const OpcodeInfo &opcodeInfo{decodeEntry._opcodeInfo};
+        switch (opcodeInfo._addressMode)
+        {
+            case AM_Indirect:
+            case AM_IndirectX:
+            case AM_IndirectY:
+            {
+                // Zero page pointers wrap within the page:
+                const Address highAddress{
+                    (opcodeInfo._addressMode == AM_Indirect) ?
+                        static_cast<Address>(instruction._operand + 1) :
+                        static_cast<Address>(static_cast<Octet>(instruction._operand + 1))};
+                for (const auto &pointerAddress: {instruction._operand, highAddress})
+                {
+                    _pointerAddresses.Insert(pointerAddress);
+                    _readAddresses.Insert(pointerAddress);
+                }
+                break;
+            }
+            default:
+                if (opcodeInfo._memoryOperation == MO_Read || opcodeInfo._memoryOperation == MO_Both)
+                    _readAddresses.Insert(instruction._operand);
+                if (opcodeInfo._memoryOperation == MO_Write || opcodeInfo._memoryOperation == MO_Both)
+                    _writtenAddresses.Insert(instruction._operand);
+                break;
+        }
+        CrossReference::Kind kind{CrossReference::XK__Unknown};
+        Address target{instruction._operand};
+        switch (decodeEntry._flowClass)
+        {
+            case FC_Branch:
+                kind = CrossReference::XK_Branch;
+                target = _lattice[address - GetOriginAddress()]._target;
+                break;
+            case FC_Call:
+                kind = CrossReference::XK_Call;
+                break;
+            case FC_Jump:
+                kind = (opcodeInfo._addressMode == AM_Indirect) ? CrossReference::XK_Read : CrossReference::XK_Jump;
+                break;
+            default:
+                // Indexed indirect and indirect indexed operands only read the pointer they name:
+                if (opcodeInfo._addressMode == AM_IndirectX || opcodeInfo._addressMode == AM_IndirectY)
+                {
+                    kind = CrossReference::XK_Read;
+                    break;
+                }
+                switch (opcodeInfo._memoryOperation)
+                {
+                    case MO_Both: kind = CrossReference::XK_Modify; break;
+                    case MO_Read: kind = CrossReference::XK_Read; break;
+                    case MO_Write: kind = CrossReference::XK_Write; break;
+                    default: break;
+                }
+                break;
+        }
+        if (kind != CrossReference::XK__Unknown)
+            pairs.push_back({target, {address, kind}});
+    }
+    _xrefIndex.Build(pairs);
+}
+
+void
+Analyzer::InferFlowGraph ()
+{
+    // Blocks run through code segments, beginning where a segment does or where a branch, jump or call lands, and
+    // ending with any instruction that transfers control.  Illegal opcodes belong to no block:
+    AddressBitmap targets;
+    auto targetHandler{
+        [this, &targets] (const Address &address, const LatticeEntry &latticeEntry) -> bool
+        {
+            if (latticeEntry._flowClass == FC_Branch || latticeEntry._flowClass == FC_Call ||
+                (latticeEntry._flowClass == FC_Jump &&
+                    LookupOpcodeInfo(_assembly[address - GetOriginAddress()])._addressMode != AM_Indirect))
+                targets.Insert(latticeEntry._target);
+            return false;
+        }};
+    for (const auto &pair: GetSegments())
+        if (pair.second.IsCode())
+            WalkInstructions(
+                pair.second._startAddress,
+                pair.second._endAddress,
+                targetHandler,
+                [] (const Address &address, const Opcode &opcode) -> void {});
+
+    // { block, last instruction address }
+    std::vector<std::pair<BasicBlock, Address>> blocks;
+    AddressBitmap blockStarts;
+    std::optional<std::pair<BasicBlock, Address>> blockOpt;
+    auto closeBlock{
+        [&blocks, &blockStarts, &blockOpt] () -> void
+        {
+            if (blockOpt && blockStarts.Insert(blockOpt->first._startAddress))
+                blocks.push_back(*blockOpt);
+            blockOpt.reset();
+        }};
+    auto blockHandler{
+        [this, &targets, &blockOpt, &closeBlock] (const Address &address, const LatticeEntry &latticeEntry) -> bool
+        {
+            if (blockOpt && targets.Contains(address))
+                closeBlock();
+            if (!blockOpt)
+                blockOpt = {{address, address, {}}, address};
+            blockOpt->first._endAddress = static_cast<Address>(address + latticeEntry._length - 1);
+            blockOpt->first._cycles += LookupCycleRange(address, DecodeInstruction(address));
+            blockOpt->second = address;
+            if (latticeEntry._flowClass != FC_None)
+                closeBlock();
+            return false;
+        }};
+    for (const auto &pair: GetSegments())
+        if (pair.second.IsCode())
+        {
+            WalkInstructions(
+                pair.second._startAddress,
+                pair.second._endAddress,
+                blockHandler,
+                [&closeBlock] (const Address &address, const Opcode &opcode) -> void { closeBlock(); });
+            closeBlock();
+        }
+    std::sort(
+        std::begin(blocks),
+        std::end(blocks),
+        [] (const std::pair<BasicBlock, Address> &left, const std::pair<BasicBlock, Address> &right)
+        { return left.first._startAddress < right.first._startAddress; });
+
+    std::vector<BasicBlock> basicBlocks;
+    for (const auto &pair: blocks)
+        basicBlocks.push_back(pair.first);
+    _flowGraph.SetBlocks(std::move(basicBlocks));
+
+    // Link blocks through the instruction ending each:
+    for (uint32_t blockIndex{0}; blockIndex < blocks.size(); ++blockIndex)
+    {
+        const auto &lastAddress{blocks[blockIndex].second};
+        const LatticeEntry &latticeEntry{_lattice[lastAddress - GetOriginAddress()]};
+        const uint32_t nextLocation{lastAddress + static_cast<uint32_t>(latticeEntry._length)};
+        auto addSuccessor{
+            [this, blockIndex] (uint32_t address, FlowEdge::Kind kind) -> void
+            {
+                if (address < AddressSpace::kSize)
+                {
+                    const auto blockIndexOpt{_flowGraph.FindBlockStart(static_cast<Address>(address))};
+                    if (blockIndexOpt)
+                        _flowGraph.AddSuccessor(blockIndex, {*blockIndexOpt, kind});
+                }
+            }};
+        switch (latticeEntry._flowClass)
+        {
+            case FC_None:
+                addSuccessor(nextLocation, FlowEdge::EK_FallThrough);
+                break;
+            case FC_Branch:
+                addSuccessor(latticeEntry._target, FlowEdge::EK_Branch);
+                addSuccessor(nextLocation, FlowEdge::EK_FallThrough);
+                break;
+            case FC_Jump:
+                if (LookupOpcodeInfo(_assembly[lastAddress - GetOriginAddress()])._addressMode != AM_Indirect)
+                    addSuccessor(latticeEntry._target, FlowEdge::EK_Jump);
+                break;
+            case FC_Call:
+                addSuccessor(latticeEntry._target, FlowEdge::EK_Call);
+                addSuccessor(nextLocation, FlowEdge::EK_Return);
+                break;
+
+            default: break;
+        }
+    }
+    _flowGraph.LinkPredecessors();
+}
+
+void
+Analyzer::InferLoops ()
+{
+    // A loop closes where a BNE or BPL branches back to the start of its own block or an earlier one.  It is counted by
+    // X or Y if the last instruction before the branch to set the flag it tests is a DEX, DEY, INX or INY, or for a BPL
+    // a DEX or DEY, which is the only write of the register in the loop, and the loop is otherwise straight-line code
+    // or holds loops found already.  Candidates are taken shortest first so inner loops are found before the loops
+    // holding them:
+    static constexpr Opcode kBneOpcode{0xD0};
+    static constexpr Opcode kBplOpcode{0x10};
+
+    const auto originAddress{GetOriginAddress()};
+    const auto blocks{_flowGraph.GetBlocks()};
+
+    // { start address, branch address }
+    std::vector<std::pair<Address, Address>> candidates;
+    for (uint32_t blockIndex{0}; blockIndex < blocks.size(); ++blockIndex)
+        for (const auto &edge: _flowGraph.GetSuccessors(blockIndex))
+        {
+            const Address branchAddress{static_cast<Address>(blocks[blockIndex]._endAddress - 1)};
+            if (edge._kind == FlowEdge::EK_Branch &&
+                blocks[edge._blockIndex]._startAddress <= blocks[blockIndex]._startAddress &&
+                (_assembly[branchAddress - originAddress] == kBneOpcode ||
+                    _assembly[branchAddress - originAddress] == kBplOpcode))
+                candidates.emplace_back(blocks[edge._blockIndex]._startAddress, branchAddress);
+        }
+    std::stable_sort(
+        std::begin(candidates),
+        std::end(candidates),
+        [] (const std::pair<Address, Address> &left, const std::pair<Address, Address> &right)
+        { return left.second - left.first < right.second - right.first; });
+
+    auto writtenCounter{
+        [] (const Mnemonic &mnemonic) -> Loop::Counter
+        {
+            switch (mnemonic)
+            {
+                case M_DEX: case M_INX: case M_LDX: case M_TAX: case M_TSX: return Loop::LC_X;
+                case M_DEY: case M_INY: case M_LDY: case M_TAY: return Loop::LC_Y;
+                default: return Loop::LC__Unknown;
+            }
+        }};
+    // Z and N are set together:
+    auto isSettingFlags{
+        [] (const Mnemonic &mnemonic) -> bool
+        {
+            switch (mnemonic)
+            {
+                case M_CLC: case M_CLD: case M_CLI: case M_CLV: case M_NOP: case M_PHA: case M_PHP: case M_SEC:
+                case M_SED: case M_SEI: case M_STA: case M_STX: case M_STY: case M_TXS:
+                    return false;
+                default: return true;
+            }
+        }};
+
+    std::map<Address, Loop> loops;
+    for (const auto &candidate: candidates)
+    {
+        const Address &startAddress{candidate.first};
+        const Address &branchAddress{candidate.second};
+        if (loops.count(startAddress) != 0)
+            continue;
+
+        // Inner loops count as a whole, their counters taken as spent:
+        bool isStraight{true};
+        uint32_t innerEndLocation{0};
+        CycleRange bodyCycles{};
+        std::optional<Mnemonic> flagSetterOpt;
+        std::array<uint16_t, Loop::LC_Y + 1> counterWrites{};
+        WalkInstructions(
+            startAddress,
+            static_cast<Address>(branchAddress - 1),
+            [this, &branchAddress, &writtenCounter, &isSettingFlags, &loops, &isStraight, &innerEndLocation,
+                &bodyCycles, &flagSetterOpt, &counterWrites] (const Address &address, const LatticeEntry &latticeEntry)
+                -> bool
+            {
+                const Instruction instruction{DecodeInstruction(address)};
+                const Mnemonic &mnemonic{instruction.GetOpcodeInfo()._mnemonic};
+                ++counterWrites[writtenCounter(mnemonic)];
+                if (address < innerEndLocation)
+                    return false;
+
+                const auto innerItor{loops.find(address)};
+                if (innerItor != std::end(loops))
+                {
+                    const Loop &inner{innerItor->second};
+                    isStraight = isStraight && inner._isCounted && inner._endAddress < branchAddress;
+                    bodyCycles += inner._totalCycles;
+                    flagSetterOpt = M__Unknown;
+                    innerEndLocation = inner._endAddress + 1u;
+                    return !isStraight;
+                }
+
+                isStraight = latticeEntry._flowClass == FC_None;
+                bodyCycles += LookupCycleRange(address, instruction);
+                if (isSettingFlags(mnemonic))
+                    flagSetterOpt = mnemonic;
+                return !isStraight;
+            },
+            [&isStraight] (const Address &address, const Opcode &opcode) -> void { isStraight = false; });
+        if (!isStraight || !flagSetterOpt)
+            continue;
+
+        // A BPL runs a counter down through zero to $FF:
+        const bool isClosedByBpl{_assembly[branchAddress - originAddress] == kBplOpcode};
+        Loop loop{startAddress, static_cast<Address>(branchAddress + 1), writtenCounter(*flagSetterOpt)};
+        loop._isCountingDown = (*flagSetterOpt == M_DEX || *flagSetterOpt == M_DEY);
+        if (loop._counter == Loop::LC__Unknown || counterWrites[loop._counter] != 1 ||
+            (!loop._isCountingDown && (isClosedByBpl || (*flagSetterOpt != M_INX && *flagSetterOpt != M_INY))))
+            continue;
+
+        // The counter's initial value is the constant the last write in every block leading in from outside loads:
+        const auto startBlockIndexOpt{_flowGraph.FindBlockStart(startAddress)};
+        std::optional<Octet> initialValueOpt;
+        bool isConstant{startBlockIndexOpt.has_value()};
+        for (const auto &edge: isConstant ? _flowGraph.GetPredecessors(*startBlockIndexOpt) : Span<FlowEdge>{})
+        {
+            const BasicBlock &block{blocks[edge._blockIndex]};
+            if (block._startAddress >= startAddress && block._startAddress <= branchAddress)
+                continue;
+            std::optional<Octet> valueOpt;
+            WalkInstructions(
+                block._startAddress,
+                block._endAddress,
+                [this, &loop, &writtenCounter, &valueOpt] (const Address &address, const LatticeEntry &latticeEntry)
+                    -> bool
+                {
+                    const Instruction instruction{DecodeInstruction(address)};
+                    const OpcodeInfo &opcodeInfo{instruction.GetOpcodeInfo()};
+                    if (writtenCounter(opcodeInfo._mnemonic) == loop._counter)
+                        valueOpt = (opcodeInfo._addressMode == AM_Immediate)
+                            ? std::optional<Octet>{static_cast<Octet>(instruction._operand)}
+                            : std::nullopt;
+                    return false;
+                },
+                [] (const Address &address, const Opcode &opcode) -> void {});
+            isConstant = edge._kind != FlowEdge::EK_Return && valueOpt &&
+                (!initialValueOpt || *initialValueOpt == *valueOpt);
+            if (!isConstant)
+                break;
+            initialValueOpt = valueOpt;
+        }
+
+        const CycleRange branchCycles{LookupCycleRange(branchAddress, DecodeInstruction(branchAddress))};
+        loop._iterationCycles = bodyCycles;
+        loop._iterationCycles += {branchCycles._max, branchCycles._max};
+        // A BPL loop counted down from $80 or above leaves at once or only after wrapping, so its count is not taken:
+        if (isConstant && initialValueOpt && (!isClosedByBpl || *initialValueOpt < 0x80))
+        {
+            loop._isCounted = true;
+            loop._initialValue = *initialValueOpt;
+            if (isClosedByBpl)
+                loop._iterationCount = loop._initialValue + 1u;
+            else
+                loop._iterationCount = (loop._initialValue == 0)
+                    ? 0x100
+                    : (loop._isCountingDown ? loop._initialValue : 0x100 - loop._initialValue);
+            const uint32_t count{loop._iterationCount};
+            loop._totalCycles = {
+                count * bodyCycles._min + (count - 1) * branchCycles._max + branchCycles._min,
+                count * bodyCycles._max + (count - 1) * branchCycles._max + branchCycles._min};
+        }
+        loops.emplace(startAddress, loop);
+    }
+
+    for (const auto &pair: loops)
+        _loops.push_back(pair.second);
+}
+
+CycleRange
+Analyzer::CountCodeSegmentCycles (const Segment &segment) const
+{
+    CycleRange result{};
+    WalkInstructions(
+        segment._startAddress,
+        segment._endAddress,
+        [this, &result] (const Address &address, const LatticeEntry &latticeEntry) -> bool
+        {
+            result += LookupCycleRange(address, DecodeInstruction(address));
+            return false;
+        },
+        [] (const Address &address, const Opcode &opcode) -> void {});
+    return result;
+}
+
 MD5
 Analyzer::FingerprintCodeSegment (const Segment &segment) const
 {
     std::vector<Octet> filtered;
     auto legalHandler{
-        [this, &filtered] (const Address &address, const Instruction &instruction) -> bool
+        [this, &filtered] (const Address &address, const LatticeEntry &latticeEntry) -> bool
         {
+            const Instruction instruction{DecodeInstruction(address)};
             filtered.push_back(instruction._opcode);
-            switch (instruction._opcodeInfo._addressMode)
+            switch (instruction.GetOpcodeInfo()._addressMode)
             {
                 case AM_Accumulator:
                 case AM_Implied:
@@ -673,8 +2037,8 @@ Analyzer::FingerprintCodeSegment (const Segment &segment) const
             }
             return false;
         }};
-    auto illegalHandler{std::function<void (const Address &address, const Opcode &opcode)>()};
-    DecodeInstructions(segment._startAddress, segment._endAddress, legalHandler, illegalHandler);
+    auto illegalHandler{[] (const Address &address, const Opcode &opcode) -> void {}};
+    WalkInstructions(segment._startAddress, segment._endAddress, legalHandler, illegalHandler);
 
     MD5 result;
     result.update(filtered.data(), static_cast<MD5::size_type>(filtered.size()));
@@ -761,17 +2125,17 @@ Analyzer::LookupLabel (const Address &address, std::optional<MemoryOperation> me
 void
 Analyzer::Analyze ()
 {
+    if (_isDetectingOrigin)
+        DetectOriginAddress();
     InitializeAssembly();
+    InitializeLattice();
 
     InitializeLedges();
-    if (InferLedges1())
-    {
-        InferSegments();
-        while (InferLedges2())
-            InferSegments();
-    }
+    InferLedges();
+    InferTableCandidates();
+    NumberSegments();
 
-    if (_segments.empty())
+    if (_space.GetSegmentCount() == 0)
     {
         std::string text {"Curiously, no valid segments were discovered"
                           " -- is the origin address set correctly? (see -o option)"};
@@ -782,6 +2146,79 @@ Analyzer::Analyze ()
     if (_isIlluminating)
         ExtractDarkCode();
     ExtractData();
+    InferFlowGraph();
+    InferLoops();
+
+    InferCallGraph();
+
+    InferCrossReferences();
+}
+
+
+void
+Analyzer::Reset ()
+{
+    // Clearing returns container nodes to the pool and leaves vectors their capacity:
+    _allVectorAddresses.Clear();
+    _codeLabels.clear();
+    _dataLabels.clear();
+    _equates.clear();
+    _tables.clear();
+
+    _assembly.clear();
+    _assemblySize = 0;
+    _originAddressOpt.reset();
+    _originConfidenceOpt.reset();
+    _endAddress = 0;
+
+    _space.Clear();
+    _landCursors.fill(0);
+    _landTypes.fill(0);
+    _lattice.clear();
+    _lands.Clear();
+    _leaps.Clear();
+    _pendingLedges.clear();
+    _codeSegments.clear();
+    _vectorTableSegments.clear();
+    _vectorTableStarts.Clear();
+    _jumpVectors.Clear();
+    _vectorConstants.clear();
+    _flowGraph.Clear();
+    _callGraph.Clear();
+    _loops.clear();
+    _xrefIndex.Clear();
+    _pointerAddresses.Clear();
+    _readAddresses.Clear();
+    _writtenAddresses.Clear();
+    _tableCandidates.clear();
+    _darkCodeConfidences.clear();
+    _dataProfiles.clear();
+    _progress = {};
+    _isPartial = false;
+}
+
+void
+Analyzer::SetIlluminatingThreshold (uint16_t threshold)
+{
+    if (threshold > 100)
+        throw UsageError("illuminating threshold must be at most 100");
+    _illuminatingThreshold = threshold;
+}
+
+void
+Analyzer::SetJobCount (uint16_t jobCount)
+{
+    if (jobCount == 0)
+        throw UsageError("job count must be at least 1");
+    _jobCount = jobCount;
+}
+
+void
+Analyzer::SetTableApplyingScore (uint16_t score)
+{
+    if (score > 100)
+        throw UsageError("table applying score must be at most 100");
+    _tableApplyingScoreOpt = score;
 }
 
 }
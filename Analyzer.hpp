@@ -23,13 +23,24 @@
 #ifndef HAC65_ANALYZER_HPP
 #define HAC65_ANALYZER_HPP
 
-#include <functional>
+#include <array>
 #include <map>
+#include <memory_resource>
 #include <optional>
 #include <set>
+#include <utility>
 #include <vector>
 
+#include "AddressBitmap.hpp"
+#include "AddressSpace.hpp"
+#include "CallGraph.hpp"
+#include "DarkCodeModel.hpp"
+#include "DataProfiler.hpp"
+#include "DecodeTable.hpp"
+#include "FlowGraph.hpp"
 #include "IAnalyzer.hpp"
+#include "WordScan.hpp"
+#include "XrefIndex.hpp"
 #include "common.hpp"
 
 namespace Hac65
@@ -41,238 +52,56 @@ class Analyzer : public IAnalyzer
     const Address kResetVector{static_cast<Address>(kIrqVector - 2)};
     const Address kNmiVector{static_cast<Address>(kResetVector - 2)};
     const size_t kMaxAssemblySize{0x10000};
+    const size_t kAssemblyGuardSize{sizeof(Operand)};
     const Address kDefaultOriginAddress{0};
 
-    const std::unordered_map<Mnemonic, MnemonicInfo> kMnemonicInfos
-        {
-            {M_ADC, {"ADC"}}, {M_AND, {"AND"}}, {M_ASL, {"ASL"}}, {M_BCC, {"BCC"}}, {M_BCS, {"BCS"}},
-            {M_BEQ, {"BEQ"}}, {M_BNE, {"BNE"}}, {M_BMI, {"BMI"}}, {M_BPL, {"BPL"}}, {M_BVC, {"BVC"}},
-            {M_BVS, {"BVS"}}, {M_BIT, {"BIT"}}, {M_BRK, {"BRK"}}, {M_CLC, {"CLC"}}, {M_CLD, {"CLD"}},
-            {M_CLI, {"CLI"}}, {M_CLV, {"CLV"}}, {M_CMP, {"CMP"}}, {M_CPX, {"CPX"}}, {M_CPY, {"CPY"}},
-            {M_DEC, {"DEC"}}, {M_DEX, {"DEX"}}, {M_DEY, {"DEY"}}, {M_EOR, {"EOR"}}, {M_INC, {"INC"}},
-            {M_INX, {"INX"}}, {M_INY, {"INY"}}, {M_JMP, {"JMP"}}, {M_JSR, {"JSR"}}, {M_LDA, {"LDA"}},
-            {M_LDX, {"LDX"}}, {M_LDY, {"LDY"}}, {M_LSR, {"LSR"}}, {M_NOP, {"NOP"}}, {M_ORA, {"ORA"}},
-            {M_PHA, {"PHA"}}, {M_PHP, {"PHP"}}, {M_PLA, {"PLA"}}, {M_PLP, {"PLP"}}, {M_ROL, {"ROL"}},
-            {M_ROR, {"ROR"}}, {M_RTI, {"RTI"}}, {M_RTS, {"RTS"}}, {M_SBC, {"SBC"}}, {M_SEC, {"SEC"}},
-            {M_SED, {"SED"}}, {M_SEI, {"SEI"}}, {M_STA, {"STA"}}, {M_STX, {"STX"}}, {M_STY, {"STY"}},
-            {M_TAX, {"TAX"}}, {M_TAY, {"TAY"}}, {M_TSX, {"TSX"}}, {M_TXA, {"TXA"}}, {M_TXS, {"TXS"}},
-            {M_TYA, {"TYA"}}
-        };
-
-    const std::unordered_map<AddressMode, AddressModeInfo> kAddressModeInfos
-        {
-            {AM_Accumulator, {0, "A", ""}},
-            {AM_Absolute, {2, "", ""}},
-            {AM_AbsoluteX, {2, "", ",X"}},
-            {AM_AbsoluteY, {2, "", ",Y"}},
-            {AM_Immediate, {1, "#", ""}},
-            {AM_Implied, {0, "", ""}},
-            {AM_Indirect, {2, "(", ")"}},
-            {AM_IndirectX, {1, "(", ",X)"}},
-            {AM_IndirectY, {1, "(", "),Y"}},
-            {AM_Relative, {1, "", ""}},
-            {AM_ZeroPage, {1, "", ""}},
-            {AM_ZeroPageX, {1, "", ",X"}},
-            {AM_ZeroPageY, {1, "", ",Y"}},
-        };
-
-    const std::unordered_map<Opcode, OpcodeInfo> kOpcodeInfos
-        {
-            {0x69, {M_ADC, AM_Immediate, MO_None}},
-            {0x6d, {M_ADC, AM_Absolute, MO_Read}},
-            {0x65, {M_ADC, AM_ZeroPage, MO_Read}},
-            {0x61, {M_ADC, AM_IndirectX, MO_Read}},
-            {0x71, {M_ADC, AM_IndirectY, MO_Read}},
-            {0x75, {M_ADC, AM_ZeroPageX, MO_Read}},
-            {0x7d, {M_ADC, AM_AbsoluteX, MO_Read}},
-            {0x79, {M_ADC, AM_AbsoluteY, MO_Read}},
-            {0x29, {M_AND, AM_Immediate, MO_None}},
-            {0x2d, {M_AND, AM_Absolute, MO_Read}},
-            {0x25, {M_AND, AM_ZeroPage, MO_Read}},
-            {0x21, {M_AND, AM_IndirectX, MO_Read}},
-            {0x31, {M_AND, AM_IndirectY, MO_Read}},
-            {0x35, {M_AND, AM_ZeroPageX, MO_Read}},
-            {0x3d, {M_AND, AM_AbsoluteX, MO_Read}},
-            {0x39, {M_AND, AM_AbsoluteY, MO_Read}},
-            {0x0e, {M_ASL, AM_Absolute, MO_Both}},
-            {0x06, {M_ASL, AM_ZeroPage, MO_Both}},
-            {0x0a, {M_ASL, AM_Accumulator, MO_None}},
-            {0x16, {M_ASL, AM_ZeroPageX, MO_Both}},
-            {0x1e, {M_ASL, AM_AbsoluteX, MO_Both}},
-            {0x90, {M_BCC, AM_Relative, MO_None}},
-            {0xb0, {M_BCS, AM_Relative, MO_None}},
-            {0xf0, {M_BEQ, AM_Relative, MO_None}},
-            {0xd0, {M_BNE, AM_Relative, MO_None}},
-            {0x30, {M_BMI, AM_Relative, MO_None}},
-            {0x10, {M_BPL, AM_Relative, MO_None}},
-            {0x50, {M_BVC, AM_Relative, MO_None}},
-            {0x70, {M_BVS, AM_Relative, MO_None}},
-            {0x2c, {M_BIT, AM_Absolute, MO_Read}},
-            {0x24, {M_BIT, AM_ZeroPage, MO_Read}},
-            {0x00, {M_BRK, AM_Implied, MO_None}},
-            {0x18, {M_CLC, AM_Implied, MO_None}},
-            {0xd8, {M_CLD, AM_Implied, MO_None}},
-            {0x58, {M_CLI, AM_Implied, MO_None}},
-            {0xb8, {M_CLV, AM_Implied, MO_None}},
-            {0xc9, {M_CMP, AM_Immediate, MO_None}},
-            {0xcd, {M_CMP, AM_Absolute, MO_Read}},
-            {0xc5, {M_CMP, AM_ZeroPage, MO_Read}},
-            {0xc1, {M_CMP, AM_IndirectX, MO_Read}},
-            {0xd1, {M_CMP, AM_IndirectY, MO_Read}},
-            {0xd5, {M_CMP, AM_ZeroPageX, MO_Read}},
-            {0xdd, {M_CMP, AM_AbsoluteX, MO_Read}},
-            {0xd9, {M_CMP, AM_AbsoluteY, MO_Read}},
-            {0xe0, {M_CPX, AM_Immediate, MO_None}},
-            {0xec, {M_CPX, AM_Absolute, MO_Read}},
-            {0xe4, {M_CPX, AM_ZeroPage, MO_Read}},
-            {0xc0, {M_CPY, AM_Immediate, MO_None}},
-            {0xcc, {M_CPY, AM_Absolute, MO_Read}},
-            {0xc4, {M_CPY, AM_ZeroPage, MO_Read}},
-            {0xce, {M_DEC, AM_Absolute, MO_Both}},
-            {0xc6, {M_DEC, AM_ZeroPage, MO_Both}},
-            {0xd6, {M_DEC, AM_ZeroPageX, MO_Both}},
-            {0xde, {M_DEC, AM_AbsoluteX, MO_Both}},
-            {0xca, {M_DEX, AM_Implied, MO_None}},
-            {0x88, {M_DEY, AM_Implied, MO_None}},
-            {0x49, {M_EOR, AM_Immediate, MO_None}},
-            {0x4d, {M_EOR, AM_Absolute, MO_Read}},
-            {0x45, {M_EOR, AM_ZeroPage, MO_Read}},
-            {0x41, {M_EOR, AM_IndirectX, MO_Read}},
-            {0x51, {M_EOR, AM_IndirectY, MO_Read}},
-            {0x55, {M_EOR, AM_ZeroPageX, MO_Read}},
-            {0x5d, {M_EOR, AM_AbsoluteX, MO_Read}},
-            {0x59, {M_EOR, AM_AbsoluteY, MO_Read}},
-            {0xee, {M_INC, AM_Absolute, MO_Both}},
-            {0xe6, {M_INC, AM_ZeroPage, MO_Both}},
-            {0xf6, {M_INC, AM_ZeroPageX, MO_Both}},
-            {0xfe, {M_INC, AM_AbsoluteX, MO_Both}},
-            {0xe8, {M_INX, AM_Implied, MO_None}},
-            {0xc8, {M_INY, AM_Implied, MO_None}},
-            {OpcodeInfo::JMP_Absolute, {M_JMP, AM_Absolute, MO_None}},
-            {0x6c, {M_JMP, AM_Indirect, MO_None}},
-            {0x20, {M_JSR, AM_Absolute, MO_None}},
-            {0xa9, {M_LDA, AM_Immediate, MO_None}},
-            {0xad, {M_LDA, AM_Absolute, MO_Read}},
-            {0xa5, {M_LDA, AM_ZeroPage, MO_Read}},
-            {0xa1, {M_LDA, AM_IndirectX, MO_Read}},
-            {0xb1, {M_LDA, AM_IndirectY, MO_Read}},
-            {0xb5, {M_LDA, AM_ZeroPageX, MO_Read}},
-            {0xbd, {M_LDA, AM_AbsoluteX, MO_Read}},
-            {0xb9, {M_LDA, AM_AbsoluteY, MO_Read}},
-            {0xa2, {M_LDX, AM_Immediate, MO_None}},
-            {0xae, {M_LDX, AM_Absolute, MO_Read}},
-            {0xa6, {M_LDX, AM_ZeroPage, MO_Read}},
-            {0xbe, {M_LDX, AM_AbsoluteY, MO_Read}},
-            {0xb6, {M_LDX, AM_ZeroPageY, MO_Read}},
-            {0xa0, {M_LDY, AM_Immediate, MO_None}},
-            {0xac, {M_LDY, AM_Absolute, MO_Read}},
-            {0xa4, {M_LDY, AM_ZeroPage, MO_Read}},
-            {0xb4, {M_LDY, AM_ZeroPageX, MO_Read}},
-            {0xbc, {M_LDY, AM_AbsoluteX, MO_Read}},
-            {0x4e, {M_LSR, AM_Absolute, MO_Both}},
-            {0x46, {M_LSR, AM_ZeroPage, MO_Both}},
-            {0x4a, {M_LSR, AM_Accumulator, MO_None}},
-            {0x56, {M_LSR, AM_ZeroPageX, MO_Both}},
-            {0x5e, {M_LSR, AM_AbsoluteX, MO_Both}},
-            {0xea, {M_NOP, AM_Implied, MO_None}},
-            {0x09, {M_ORA, AM_Immediate, MO_None}},
-            {0x0d, {M_ORA, AM_Absolute, MO_Read}},
-            {0x05, {M_ORA, AM_ZeroPage, MO_Read}},
-            {0x01, {M_ORA, AM_IndirectX, MO_Read}},
-            {0x11, {M_ORA, AM_IndirectY, MO_Read}},
-            {0x15, {M_ORA, AM_ZeroPageX, MO_Read}},
-            {0x1d, {M_ORA, AM_AbsoluteX, MO_Read}},
-            {0x19, {M_ORA, AM_AbsoluteY, MO_Read}},
-            {0x48, {M_PHA, AM_Implied, MO_None}},
-            {0x08, {M_PHP, AM_Implied, MO_None}},
-            {0x68, {M_PLA, AM_Implied, MO_None}},
-            {0x28, {M_PLP, AM_Implied, MO_None}},
-            {0x2e, {M_ROL, AM_Absolute, MO_Both}},
-            {0x26, {M_ROL, AM_ZeroPage, MO_Both}},
-            {0x2a, {M_ROL, AM_Accumulator, MO_None}},
-            {0x36, {M_ROL, AM_ZeroPageX, MO_Both}},
-            {0x3e, {M_ROL, AM_AbsoluteX, MO_Both}},
-            {0x6e, {M_ROR, AM_Absolute, MO_Both}},
-            {0x66, {M_ROR, AM_ZeroPage, MO_Both}},
-            {0x6a, {M_ROR, AM_Accumulator, MO_None}},
-            {0x76, {M_ROR, AM_ZeroPageX, MO_Both}},
-            {0x7e, {M_ROR, AM_AbsoluteX, MO_Both}},
-            {0x40, {M_RTI, AM_Implied, MO_None}},
-            {0x60, {M_RTS, AM_Implied, MO_None}},
-            {0xe9, {M_SBC, AM_Immediate, MO_None}},
-            {0xed, {M_SBC, AM_Absolute, MO_Read}},
-            {0xe5, {M_SBC, AM_ZeroPage, MO_Read}},
-            {0xe1, {M_SBC, AM_IndirectX, MO_Read}},
-            {0xf1, {M_SBC, AM_IndirectY, MO_Read}},
-            {0xf5, {M_SBC, AM_ZeroPageX, MO_Read}},
-            {0xfd, {M_SBC, AM_AbsoluteX, MO_Read}},
-            {0xf9, {M_SBC, AM_AbsoluteY, MO_Read}},
-            {0x38, {M_SEC, AM_Implied, MO_None}},
-            {0xf8, {M_SED, AM_Implied, MO_None}},
-            {0x78, {M_SEI, AM_Implied, MO_None}},
-            {0x8d, {M_STA, AM_Absolute, MO_Write}},
-            {0x85, {M_STA, AM_ZeroPage, MO_Write}},
-            {0x81, {M_STA, AM_IndirectX, MO_Write}},
-            {0x91, {M_STA, AM_IndirectY, MO_Write}},
-            {0x95, {M_STA, AM_ZeroPageX, MO_Write}},
-            {0x9d, {M_STA, AM_AbsoluteX, MO_Write}},
-            {0x99, {M_STA, AM_AbsoluteY, MO_Write}},
-            {0x8e, {M_STX, AM_Absolute, MO_Write}},
-            {0x86, {M_STX, AM_ZeroPage, MO_Write}},
-            {0x96, {M_STX, AM_ZeroPageY, MO_Write}},
-            {0x8c, {M_STY, AM_Absolute, MO_Write}},
-            {0x84, {M_STY, AM_ZeroPage, MO_Write}},
-            {0x94, {M_STY, AM_ZeroPageX, MO_Write}},
-            {0xaa, {M_TAX, AM_Implied, MO_None}},
-            {0xa8, {M_TAY, AM_Implied, MO_None}},
-            {0xba, {M_TSX, AM_Implied, MO_None}},
-            {0x8a, {M_TXA, AM_Implied, MO_None}},
-            {0x9a, {M_TXS, AM_Implied, MO_None}},
-            {0x98, {M_TYA, AM_Implied, MO_None}}
-        };
-
-    struct Land
-    {
-        Address _address;
-        Segment::Type _type;
+    // The instruction decoded at one object offset; the next offset is this one plus _length.  The target is the
+    // destination of a relative branch, else the raw operand.  Illegal opcodes have an unknown flow class and a length
+    // of one:
+    struct LatticeEntry
+    {
+        Address _target;
+        uint8_t _length;
+        FlowClass _flowClass;
     };
 
-    friend bool
-    operator< (const Analyzer::Land &left, const Analyzer::Land &right);
+    // Node-based containers draw from this pool, which keeps their memory across Reset() for the next object:
+    std::pmr::unsynchronized_pool_resource _pool;
+
+    AddressBitmap _allVectorAddresses;
+
+    std::pmr::map<Address, std::string> _codeLabels{&_pool};
 
-    std::set<Address> _allVectorAddresses;
+    std::pmr::multimap<Address, std::string> _dataLabels{&_pool};
 
-    std::map<Address, std::string> _codeLabels;
+    std::pmr::multimap<uint16_t, std::string> _equates{&_pool};
 
-    std::multimap<Address, std::string> _dataLabels;
+    struct DeclaredTable
+    {
+        uint16_t _vectorCount;
+        TableLayout _layout;
+    };
 
-    std::multimap<uint16_t, std::string> _equates;
+    // Declared tables of every layout, in address order:
+    std::pmr::multimap<Address, DeclaredTable> _tables{&_pool};
 
-    // { VL -> IL, VH -> VH }
-    std::multimap<Address, uint16_t> _indirectVectorTables;
+    bool _isIlluminating{false};
 
-    // { JMP, IL, IH }
-    std::multimap<Address, uint16_t> _jumpVectorTables;
+    uint16_t _illuminatingThreshold{50};
 
-    // { <key>, VL -> (IL-1), VH -> IH }
-    std::multimap<Address, uint16_t> _keyedIndirectMinusOneVectorTables;
+    bool _isDetectingOrigin{false};
 
-    // { <key>, VL -> IL, VH -> VH }
-    std::multimap<Address, uint16_t> _keyedIndirectVectorTables;
+    uint16_t _jobCount{1};
 
-    // { <key>, IL, IH }
-    std::multimap<Address, uint16_t> _keyedVectorTables;
+    std::optional<uint16_t> _tableApplyingScoreOpt;
 
-    // { VL -> (IL-1), VH -> IH }
-    std::multimap<Address, uint16_t> _minusOneVectorTables;
+    AnalysisBudget _budget;
 
-    // { IL, IH }
-    std::multimap<Address, uint16_t> _normalVectorTables;
+    ProgressCallback _progressCallback;
 
-    // { IL, +offset:IH }
-    std::multimap<Address, uint16_t> _splitVectorTables;
+    AnalysisProgress _progress{};
 
-    bool _isIlluminating{false};
+    bool _isPartial{false};
 
     std::vector<Octet> _assembly;
 
@@ -280,47 +109,107 @@ class Analyzer : public IAnalyzer
 
     std::optional<Address> _originAddressOpt;
 
+    std::optional<uint8_t> _originConfidenceOpt;
+
     Address _endAddress{0};
 
-    std::map<Address, Octet> _data;
+    AddressSpace _space;
+
+    // The address just past the last instruction decoded from each land (0 if never decoded):
+    std::array<Address, AddressSpace::kSize> _landCursors{};
+
+    // Decoding from a land, through to the end address at most:
+    struct LedgeTask
+    {
+        Address _landAddress;
+        Address _endAddress;
+    };
+
+    // Lands (each with the land it was decoded from) and leaps found decoding from lands:
+    struct LedgeFinds
+    {
+        std::vector<std::pair<Address, Address>> _lands;
+        std::vector<Address> _leaps;
+        size_t _instructionCount{0};
+    };
+
+    // An instruction decoded at every object offset, built once per analysis:
+    std::vector<LatticeEntry> _lattice;
+
+    AddressBitmap _lands;
+
+    // The segment type of each land, set when the land is first added (types fit in an octet):
+    std::array<Octet, AddressSpace::kSize> _landTypes{};
+
+    AddressBitmap _leaps;
+
+    // Lands and leaps added since segments were last inferred:
+    std::vector<Address> _pendingLedges;
+
+    // Code segments as paired from lands and leaps, before vector table segments are laid over them:
+    std::pmr::map<Address, Segment> _codeSegments{&_pool};
 
-    std::map<Address, Opcode> _illegals;
+    std::vector<Segment> _vectorTableSegments;
 
-    std::map<Address, Instruction> _instructions;
+    AddressBitmap _vectorTableStarts;
 
-    std::set<Land> _lands;
+    // Vectors jumped through indirectly, and the constant values code was seen to store into them:
+    AddressBitmap _jumpVectors;
 
-    std::set<Address> _leaps;
+    std::pmr::set<std::pair<Address, Address>> _vectorConstants{&_pool};
 
-    std::map<Address, Segment> _segments;
+    FlowGraph _flowGraph;
+
+    CallGraph _callGraph;
+
+    // Counted loops, ordered by start address:
+    std::vector<Loop> _loops;
+
+    XrefIndex _xrefIndex;
+
+    // Operand addresses as used by instructions, indexed operands marking their base address:
+    AddressBitmap _pointerAddresses;
+
+    AddressBitmap _readAddresses;
+
+    AddressBitmap _writtenAddresses;
+
+    std::vector<TableCandidate> _tableCandidates;
+
+    // Confidence out of 100 in each inferred data segment scored for illumination being dark code:
+    std::pmr::map<Address, uint8_t> _darkCodeConfidences{&_pool};
+
+    // Octet statistics of each inferred data segment:
+    std::pmr::map<Address, DataProfile> _dataProfiles{&_pool};
 
     void
-    AddData (const Address &address, const Octet &octet)
+    AddData (const Address &address)
     {
-        _data[address] = octet;
+        _space.SetData(address);
     }
 
     void
-    AddIllegal (const Address &address, const Opcode &opcode)
+    AddIllegal (const Address &address)
     {
-        _illegals[address] = opcode;
+        _space.SetIllegal(address);
     }
 
     void
-    AddInstruction (const Address &address, const Instruction &instruction)
+    AddInstruction (const Address &address)
     {
-        _instructions[address] = instruction;
+        _space.SetInstruction(address);
     }
 
-    void
-    AddJumpVectorLedges ();
-
     bool
     AddLand (const Address &address, const Segment::Type &type)
     {
         bool result{false};
-        if (address >= GetOriginAddress())
-            result = _lands.insert({address, type}).second;
+        if (address >= GetOriginAddress() && _lands.Insert(address))
+        {
+            _landTypes[address] = static_cast<Octet>(type);
+            _pendingLedges.push_back(address);
+            result = true;
+        }
         return result;
     }
 
@@ -328,8 +217,11 @@ class Analyzer : public IAnalyzer
     AddLeap (const Address &address)
     {
         bool result{false};
-        if (address >= GetOriginAddress())
-            result = _leaps.insert(address).second;
+        if (address >= GetOriginAddress() && _leaps.Insert(address))
+        {
+            _pendingLedges.push_back(address);
+            result = true;
+        }
         return result;
     }
 
@@ -337,20 +229,28 @@ class Analyzer : public IAnalyzer
     AddSegment (const Address &segmentAddress, const Segment &segment);
 
     void
-    AddVectorIndirections ();
+    AddTableIndirections ();
 
     void
-    AddVectorLedges ();
+    AddTableLedges ();
 
     Address
     AddressToAssemblyOffset (const Address &address) const;
 
-    uint16_t
-    DecodeInstructions (
-        const Address &startAddress,
-        const Address &endAddress,
-        const std::function<bool (Address, Instruction)> &legalHandler,
-        const std::function<void (Address, Opcode)> &illegalHandler) const;
+    bool
+    ApplyTableCandidates ();
+
+    Instruction
+    DecodeInstruction (const Address &address) const;
+
+    void
+    DecodeLedges (const LedgeTask &task, bool isStoppingAtLeap, LedgeFinds &finds);
+
+    std::vector<LedgeFinds>
+    DecodeLedges (const std::vector<LedgeTask> &tasks, bool isStoppingAtLeap);
+
+    void
+    DetectOriginAddress ();
 
     void
     ExtractCode ();
@@ -361,53 +261,112 @@ class Analyzer : public IAnalyzer
     void
     ExtractData ();
 
+    std::optional<Address>
+    FindBaseSegmentAddress (const Address &address, bool isSeekingNext) const;
+
+    std::vector<TableCandidate>
+    FindTableCandidates () const;
+
+    bool
+    HasPendingLedge (uint32_t startAddress, uint32_t endAddress) const;
+
     bool
-    InferLedges1 ();
+    IsBudgetExhausted ();
+
+    void
+    InferDataSegments (std::optional<Address> lowerAddressOpt, std::optional<Address> upperAddressOpt);
 
     bool
-    InferLedges2 ();
+    InferDispatchTables (const std::vector<LedgeTask> &tasks);
+
+    void
+    InferCallGraph ();
+
+    void
+    InferCrossReferences ();
+
+    void
+    InferFlowGraph ();
+
+    void
+    InferLedges ();
 
     void
+    InferLoops ();
+
+    std::vector<Address>
     InferSegments ();
 
+    void
+    InferVectorConstants (const std::vector<LedgeTask> &tasks);
+
+    void
+    InferTableCandidates ();
+
+    void
+    InferVectorTableSegments ();
+
     void
     InitializeAssembly ();
 
+    void
+    InitializeLattice ();
+
     void
     InitializeLedges ();
 
     void
     InitializeSegments ()
     {
-        _segments.clear();
+        _space.ClearSegments();
     }
 
-    void
-    RemoveIllegal (const Address &address)
+    // Whether a code or vector table segment, rather than a data segment filling a gap between them, starts at address:
+    bool
+    IsBaseSegment (const Address &address) const
     {
-        _illegals.erase(address);
+        return _codeSegments.count(address) != 0 || _vectorTableStarts.Contains(address);
     }
 
     void
-    RemoveInstruction (const Address &address)
-    {
-        _instructions.erase(address);
-    }
+    NumberSegments ();
+
+    template <typename Emitter>
+    void
+    PairLedges (std::pmr::map<Address, Segment>::const_iterator resumeItor, Emitter &&emitter) const;
+
+    const TableLayout &
+    LookupCandidateLayout (const TableCandidate::Kind &kind) const;
+
+    Address
+    ReadCandidateTarget (const TableCandidate &candidate, uint16_t index) const;
+
+    Address
+    ReadTableVector (const Address &tableAddress, const DeclaredTable &table, uint16_t index) const;
+
+    uint8_t
+    ScoreDarkCode (const Segment &segment, std::vector<Address> &instructionAddresses) const;
 
     bool
     SegmentHasVectors (const Segment &segment)
     {
-        for (const auto &address: _allVectorAddresses)
-            if (segment._startAddress <= address && address <= segment._endAddress)
-                return true;
-            else if (address > segment._endAddress)
-                break;
-        return false;
+        return _allVectorAddresses.FindNext(segment._startAddress) <= segment._endAddress;
     }
 
+    template <typename LegalHandler, typename IllegalHandler>
+    uint16_t
+    WalkInstructions (
+        const Address &startAddress,
+        const Address &endAddress,
+        LegalHandler &&legalHandler,
+        IllegalHandler &&illegalHandler) const;
+
     void
     Analyze () override;
 
+    CycleRange
+    CountCodeSegmentCycles (const Segment &segment) const override;
+
     void
     DeclareCodeLabel (const std::string &label, const Address &address) override
     {
@@ -427,36 +386,6 @@ class Analyzer : public IAnalyzer
         _equates.insert({value, equate});
     }
 
-    void
-    DeclareIndirectVectorTable (const Address &address, uint16_t vectorCount) override
-    {
-        _indirectVectorTables.insert({address, vectorCount});
-    }
-
-    void
-    DeclareJumpVectorTable (const Address &address, uint16_t vectorCount) override
-    {
-        _jumpVectorTables.insert({address, vectorCount});
-    }
-
-    void
-    DeclareKeyedIndirectVectorTable (const Address &address, uint16_t vectorCount) override
-    {
-        _keyedIndirectVectorTables.insert({address, vectorCount});
-    }
-
-    void
-    DeclareKeyedIndirectMinusOneVectorTable (const Address &address, uint16_t vectorCount) override
-    {
-        _keyedIndirectMinusOneVectorTables.insert({address, vectorCount});
-    }
-
-    void
-    DeclareKeyedVectorTable (const Address &address, uint16_t vectorCount) override
-    {
-        _keyedVectorTables.insert({address, vectorCount});
-    }
-
     bool
     DeclareLand (const Address &address) override
     {
@@ -470,27 +399,29 @@ class Analyzer : public IAnalyzer
     }
 
     void
-    DeclareMinusOneVectorTable (const Address &address, uint16_t vectorCount) override
+    DeclareOriginAddress (const Address &address) override
     {
-        _minusOneVectorTables.insert({address, vectorCount});
+        _originAddressOpt = std::optional<Address>(address);
     }
 
     void
-    DeclareNormalVectorTable (const Address &address, uint16_t vectorCount) override
+    DeclareTable (const Address &address, uint16_t vectorCount, const TableLayout &layout) override
     {
-        _normalVectorTables.insert({address, vectorCount});
+        _tables.insert({address, {vectorCount, layout}});
     }
 
-    void
-    DeclareOriginAddress (const Address &address) override
+    Span<CrossReference>
+    FindCrossReferences (const Address &address) const override
     {
-        _originAddressOpt = std::optional<Address>(address);
+        const auto targetIndexOpt{_xrefIndex.FindTarget(address)};
+        return targetIndexOpt ? _xrefIndex.GetReferences(*targetIndexOpt) : Span<CrossReference>{};
     }
 
-    void
-    DeclareSplitVectorTable (const Address &address, uint16_t vectorCount) override
+    std::optional<size_t>
+    FindBasicBlock (const Address &address) const override
     {
-        _splitVectorTables.insert({address, vectorCount});
+        const auto blockIndexOpt{_flowGraph.FindBlock(address)};
+        return blockIndexOpt ? std::optional<size_t>{*blockIndexOpt} : std::nullopt;
     }
 
     MD5
@@ -511,22 +442,58 @@ class Analyzer : public IAnalyzer
         return _assemblySize;
     }
 
-    const std::map<Address, Octet> &
+    Span<BasicBlock>
+    GetBasicBlocks () const override
+    {
+        return _flowGraph.GetBlocks();
+    }
+
+    Span<uint32_t>
+    GetCallees (size_t subroutineIndex) const override
+    {
+        return _callGraph.GetCallees(subroutineIndex);
+    }
+
+    size_t
+    GetCallComponentCount () const override
+    {
+        return _callGraph.GetComponentCount();
+    }
+
+    Span<Address>
+    GetCrossReferencedAddresses () const override
+    {
+        return _xrefIndex.GetTargets();
+    }
+
+    Span<CrossReference>
+    GetCrossReferences (size_t addressIndex) const override
+    {
+        return _xrefIndex.GetReferences(addressIndex);
+    }
+
+    DataView
     GetData () const override
     {
-        return _data;
+        return DataView(_space);
     }
 
-    const std::map<Address, Opcode> &
+    IllegalsView
     GetIllegals () const override
     {
-        return _illegals;
+        return IllegalsView(_space);
     }
 
-    const std::map<Address, Instruction> &
+    InstructionsView
     GetInstructions () const override
     {
-        return _instructions;
+        return InstructionsView(_space);
+    }
+
+    Span<Loop>
+    GetLoops () const override
+    {
+        return {_loops.data(), _loops.size()};
     }
 
     Address
@@ -535,10 +502,64 @@ class Analyzer : public IAnalyzer
         return _originAddressOpt.value_or(kDefaultOriginAddress);
     }
 
-    const std::map<Address, Segment> &
+    std::optional<uint8_t>
+    GetOriginConfidence () const override
+    {
+        return _originConfidenceOpt;
+    }
+
+    const AddressBitmap &
+    GetPointerAddresses () const override
+    {
+        return _pointerAddresses;
+    }
+
+    Span<FlowEdge>
+    GetPredecessors (size_t blockIndex) const override
+    {
+        return _flowGraph.GetPredecessors(blockIndex);
+    }
+
+    const AddressBitmap &
+    GetReadAddresses () const override
+    {
+        return _readAddresses;
+    }
+
+    SegmentsView
     GetSegments () const override
     {
-        return _segments;
+        return SegmentsView(_space);
+    }
+
+    Span<Subroutine>
+    GetSubroutines () const override
+    {
+        return _callGraph.GetSubroutines();
+    }
+
+    Span<FlowEdge>
+    GetSuccessors (size_t blockIndex) const override
+    {
+        return _flowGraph.GetSuccessors(blockIndex);
+    }
+
+    Span<TableCandidate>
+    GetTableCandidates () const override
+    {
+        return {_tableCandidates.data(), _tableCandidates.size()};
+    }
+
+    const AddressBitmap &
+    GetWrittenAddresses () const override
+    {
+        return _writtenAddresses;
+    }
+
+    bool
+    IsPartial () const override
+    {
+        return _isPartial;
     }
 
     bool
@@ -550,7 +571,27 @@ class Analyzer : public IAnalyzer
     const AddressModeInfo &
     LookupAddressModeInfo (const AddressMode &addressMode) const override
     {
-        return kAddressModeInfos.at(addressMode);
+        return Hac65::LookupAddressModeInfo(addressMode);
+    }
+
+    CycleRange
+    LookupCycleRange (const Address &address, const Instruction &instruction) const override
+    {
+        return Hac65::LookupCycleRange(address, instruction);
+    }
+
+    std::optional<uint8_t>
+    LookupDarkCodeConfidence (const Address &address) const override
+    {
+        const auto itor{_darkCodeConfidences.find(address)};
+        return (itor == std::end(_darkCodeConfidences)) ? std::nullopt : std::optional<uint8_t>{itor->second};
+    }
+
+    std::optional<DataProfile>
+    LookupDataProfile (const Address &address) const override
+    {
+        const auto itor{_dataProfiles.find(address)};
+        return (itor == std::end(_dataProfiles)) ? std::nullopt : std::optional<DataProfile>{itor->second};
     }
 
     const std::optional<std::vector<std::string>>
@@ -562,20 +603,30 @@ class Analyzer : public IAnalyzer
     const MnemonicInfo &
     LookupMnemonicInfo (const Mnemonic &mnemonic) const override
     {
-        return kMnemonicInfos.at(mnemonic);
+        return Hac65::LookupMnemonicInfo(mnemonic);
     }
 
     const OpcodeInfo &
     LookupOpcodeInfo (const Opcode &opcode) const override
     {
-        return kOpcodeInfos.at(opcode);
+        return Hac65::LookupOpcodeInfo(opcode);
     }
 
+    void
+    Reset () override;
+
     void
     SetAssembly (std::vector<Octet> assembly) override
     {
         _assembly = std::move(assembly);
         _assemblySize = _assembly.size();
+        _assembly.resize(_assemblySize + kAssemblyGuardSize, 0);
+    }
+
+    void
+    SetBudget (const AnalysisBudget &budget) override
+    {
+        _budget = budget;
     }
 
     void
@@ -583,13 +634,28 @@ class Analyzer : public IAnalyzer
     {
         _isIlluminating = true;
     }
-};
 
-inline bool
-operator< (const Analyzer::Land &left, const Analyzer::Land &right)
-{
-    return left._address < right._address;
-}
+    void
+    SetIlluminatingThreshold (uint16_t threshold) override;
+
+    void
+    SetJobCount (uint16_t jobCount) override;
+
+    void
+    SetOriginDetectingMode () override
+    {
+        _isDetectingOrigin = true;
+    }
+
+    void
+    SetProgressCallback (ProgressCallback progressCallback) override
+    {
+        _progressCallback = std::move(progressCallback);
+    }
+
+    void
+    SetTableApplyingScore (uint16_t score) override;
+};
 
 }
 
@@ -0,0 +1,230 @@
+//
+// HAC/65 6502 Inferencing Disassembler
+//
+// This work is licensed under the MIT License <https://opensource.org/licenses/MIT>
+// Copyright 2018 David Hinson <https://github.com/dhinson919>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Portions of this work are derived from the RSA Data Security, Inc. MD5 Message-Digest Algorithm
+//
+
+#ifndef HAC65_CALLGRAPH_HPP
+#define HAC65_CALLGRAPH_HPP
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "common.hpp"
+
+namespace Hac65
+{
+
+// Subroutine call graph in compressed sparse row form.  Subroutines are ordered by entry address; the callees of
+// subroutine n, as subroutine indexes, occupy [_calleeOffsets[n], _calleeOffsets[n + 1]) of _callees.
+class CallGraph
+{
+    std::vector<Subroutine> _subroutines;
+
+    std::vector<uint32_t> _calleeOffsets;
+
+    std::vector<uint32_t> _callees;
+
+    size_t _componentCount{0};
+
+    // Completes the component of subroutines just popped, whose callees outside it are all complete:
+    void
+    SummarizeComponent (const std::vector<uint32_t> &members)
+    {
+        Subroutine summary{};
+        bool isCalling{false};
+        for (const auto &member: members)
+        {
+            summary._writtenRegisters |= _subroutines[member]._writtenRegisters;
+            summary._writtenZeroPage |= _subroutines[member]._writtenZeroPage;
+            for (const auto &callee: GetCallees(member))
+            {
+                const Subroutine &calleeSubroutine{_subroutines[callee]};
+                if (callee == member)
+                    summary._isRecursive = true;
+                else if (calleeSubroutine._componentIndex != _componentCount)
+                {
+                    summary._writtenRegisters |= calleeSubroutine._writtenRegisters;
+                    summary._writtenZeroPage |= calleeSubroutine._writtenZeroPage;
+                    summary._maxCallDepth = std::max(summary._maxCallDepth, calleeSubroutine._maxCallDepth);
+                    isCalling = true;
+                }
+            }
+        }
+        for (const auto &member: members)
+        {
+            auto &subroutine{_subroutines[member]};
+            subroutine._maxCallDepth = static_cast<uint16_t>(summary._maxCallDepth + (isCalling ? 1 : 0));
+            subroutine._writtenRegisters = summary._writtenRegisters;
+            subroutine._writtenZeroPage = summary._writtenZeroPage;
+            subroutine._isRecursive = summary._isRecursive || members.size() > 1;
+        }
+        ++_componentCount;
+    }
+
+public:
+    // Callees must be added in subroutine order:
+    void
+    AddCallee (uint32_t subroutineIndex, uint32_t calleeIndex)
+    {
+        assert(subroutineIndex < _subroutines.size() && subroutineIndex + 1 >= _calleeOffsets.size());
+        while (_calleeOffsets.size() <= subroutineIndex)
+            _calleeOffsets.push_back(static_cast<uint32_t>(_callees.size()));
+        _callees.push_back(calleeIndex);
+    }
+
+    void
+    Clear ()
+    {
+        _subroutines.clear();
+        _calleeOffsets.clear();
+        _callees.clear();
+        _componentCount = 0;
+    }
+
+    // Closes the callee rows, then condenses the graph into its strongly connected components with Tarjan's algorithm,
+    // iteratively.  Components complete callees first, so each is summarized from its members' own summaries and
+    // those of its callees in the same traversal:
+    void
+    Condense ()
+    {
+        static constexpr uint32_t kUnvisited{std::numeric_limits<uint32_t>::max()};
+
+        while (_calleeOffsets.size() <= _subroutines.size())
+            _calleeOffsets.push_back(static_cast<uint32_t>(_callees.size()));
+
+        const auto subroutineCount{static_cast<uint32_t>(_subroutines.size())};
+        std::vector<uint32_t> visitIndexes(subroutineCount, kUnvisited);
+        std::vector<uint32_t> lowLinks(subroutineCount);
+        std::vector<bool> isStacked(subroutineCount);
+        std::vector<uint32_t> stack;
+        std::vector<uint32_t> members;
+
+        // { subroutine, next callee offset }
+        std::vector<std::pair<uint32_t, uint32_t>> frames;
+
+        uint32_t visitCount{0};
+        auto visit{
+            [this, &visitIndexes, &lowLinks, &isStacked, &stack, &frames, &visitCount] (
+                uint32_t subroutineIndex) -> void
+            {
+                visitIndexes[subroutineIndex] = lowLinks[subroutineIndex] = visitCount++;
+                stack.push_back(subroutineIndex);
+                isStacked[subroutineIndex] = true;
+                frames.push_back({subroutineIndex, _calleeOffsets[subroutineIndex]});
+            }};
+
+        _componentCount = 0;
+        for (uint32_t rootIndex{0}; rootIndex < subroutineCount; ++rootIndex)
+        {
+            if (visitIndexes[rootIndex] != kUnvisited)
+                continue;
+            visit(rootIndex);
+            while (!frames.empty())
+            {
+                const uint32_t subroutineIndex{frames.back().first};
+                const uint32_t calleeOffset{frames.back().second};
+                if (calleeOffset < _calleeOffsets[subroutineIndex + 1])
+                {
+                    ++frames.back().second;
+                    const uint32_t calleeIndex{_callees[calleeOffset]};
+                    if (visitIndexes[calleeIndex] == kUnvisited)
+                        visit(calleeIndex);
+                    else if (isStacked[calleeIndex])
+                        lowLinks[subroutineIndex] = std::min(lowLinks[subroutineIndex], visitIndexes[calleeIndex]);
+                    continue;
+                }
+
+                frames.pop_back();
+                if (!frames.empty())
+                {
+                    auto &callerLowLink{lowLinks[frames.back().first]};
+                    callerLowLink = std::min(callerLowLink, lowLinks[subroutineIndex]);
+                }
+                if (lowLinks[subroutineIndex] == visitIndexes[subroutineIndex])
+                {
+                    members.clear();
+                    uint32_t memberIndex{0};
+                    do
+                    {
+                        memberIndex = stack.back();
+                        stack.pop_back();
+                        isStacked[memberIndex] = false;
+                        _subroutines[memberIndex]._componentIndex = static_cast<uint32_t>(_componentCount);
+                        members.push_back(memberIndex);
+                    }
+                    while (memberIndex != subroutineIndex);
+                    SummarizeComponent(members);
+                }
+            }
+        }
+    }
+
+    // Finds the subroutine entered at address, if any:
+    std::optional<uint32_t>
+    FindSubroutine (const Address &address) const
+    {
+        std::optional<uint32_t> resultOpt;
+        auto itor{std::lower_bound(
+            std::begin(_subroutines),
+            std::end(_subroutines),
+            address,
+            [] (const Subroutine &subroutine, const Address &value) { return subroutine._entryAddress < value; })};
+        if (itor != std::end(_subroutines) && itor->_entryAddress == address)
+            resultOpt = static_cast<uint32_t>(itor - std::begin(_subroutines));
+        return resultOpt;
+    }
+
+    Span<uint32_t>
+    GetCallees (size_t subroutineIndex) const
+    {
+        assert(subroutineIndex < _subroutines.size());
+        const auto offset{_calleeOffsets[subroutineIndex]};
+        return {_callees.data() + offset, _calleeOffsets[subroutineIndex + 1] - offset};
+    }
+
+    size_t
+    GetComponentCount () const
+    {
+        return _componentCount;
+    }
+
+    Span<Subroutine>
+    GetSubroutines () const
+    {
+        return {_subroutines.data(), _subroutines.size()};
+    }
+
+    // Replaces the graph with subroutines summarized alone, which must be ordered by entry address:
+    void
+    SetSubroutines (std::vector<Subroutine> subroutines)
+    {
+        _subroutines = std::move(subroutines);
+        _calleeOffsets.clear();
+        _callees.clear();
+        _componentCount = 0;
+    }
+};
+
+}
+
+#endif //HAC65_CALLGRAPH_HPP
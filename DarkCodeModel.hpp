@@ -0,0 +1,295 @@
+//
+// HAC/65 6502 Inferencing Disassembler
+//
+// This work is licensed under the MIT License <https://opensource.org/licenses/MIT>
+// Copyright 2018 David Hinson <https://github.com/dhinson919>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Portions of this work are derived from the RSA Data Security, Inc. MD5 Message-Digest Algorithm
+//
+
+#ifndef HAC65_DARKCODEMODEL_HPP
+#define HAC65_DARKCODEMODEL_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "DecodeTable.hpp"
+#include "common.hpp"
+
+namespace Hac65
+{
+
+// Opcodes grouped by the part they play, for telling code from data by the company instructions keep:
+enum OpcodeClass : Octet
+{
+    OC_Illegal,
+    OC_Load,        // LDA LDX LDY
+    OC_Store,       // STA STX STY
+    OC_Arithmetic,  // ADC SBC AND ORA EOR BIT
+    OC_Compare,     // CMP CPX CPY
+    OC_Modify,      // ASL LSR ROL ROR INC DEC INX INY DEX DEY
+    OC_Branch,
+    OC_Jump,        // JMP JSR
+    OC_Return,      // RTS RTI
+    OC_Transfer,    // TAX TAY TXA TYA TSX TXS PHA PLA PHP PLP
+    OC_Flag,        // CLC CLD CLI CLV SEC SED SEI
+    OC_Break        // BRK NOP
+};
+
+inline constexpr size_t kOpcodeClassCount{OC_Break + 1};
+
+constexpr OpcodeClass
+MnemonicToOpcodeClass (const Mnemonic &mnemonic)
+{
+    switch (mnemonic)
+    {
+        case M_LDA: case M_LDX: case M_LDY: return OC_Load;
+        case M_STA: case M_STX: case M_STY: return OC_Store;
+        case M_ADC: case M_SBC: case M_AND: case M_ORA: case M_EOR: case M_BIT: return OC_Arithmetic;
+        case M_CMP: case M_CPX: case M_CPY: return OC_Compare;
+        case M_ASL: case M_LSR: case M_ROL: case M_ROR: case M_INC: case M_DEC: case M_INX: case M_INY: case M_DEX:
+        case M_DEY:
+            return OC_Modify;
+        case M_BCC: case M_BCS: case M_BEQ: case M_BNE: case M_BMI: case M_BPL: case M_BVC: case M_BVS:
+            return OC_Branch;
+        case M_JMP: case M_JSR: return OC_Jump;
+        case M_RTS: case M_RTI: return OC_Return;
+        case M_TAX: case M_TAY: case M_TXA: case M_TYA: case M_TSX: case M_TXS: case M_PHA: case M_PLA: case M_PHP:
+        case M_PLP:
+            return OC_Transfer;
+        case M_CLC: case M_CLD: case M_CLI: case M_CLV: case M_SEC: case M_SED: case M_SEI: return OC_Flag;
+        case M_BRK: case M_NOP: return OC_Break;
+        default: return OC_Illegal;
+    }
+}
+
+constexpr std::array<OpcodeClass, 0x100>
+MakeOpcodeClassTable ()
+{
+    std::array<OpcodeClass, 0x100> result{};
+    for (size_t opcode{0}; opcode < result.size(); ++opcode)
+        result[opcode] = MnemonicToOpcodeClass(kDecodeTable[opcode]._opcodeInfo._mnemonic);
+    return result;
+}
+
+inline constexpr std::array<OpcodeClass, 0x100> kOpcodeClassTable{MakeOpcodeClassTable()};
+
+constexpr OpcodeClass
+LookupOpcodeClass (const Opcode &opcode)
+{
+    return kOpcodeClassTable[opcode];
+}
+
+// Log-odds, in quarter nats, of an opcode class appearing in code rather than in data: first on its own, then after
+// one class, then after two.  Tallied with add-one smoothing from the code and data segments of the annotated 1050
+// and 800 ROMs, the data decoded from every offset.  The segments are listed in tools/DarkCodeCorpus.txt, from which
+// dark-code-trainer reproduces these tables.  Columns follow OpcodeClass order:
+inline constexpr int8_t kUnigramLogOdds[kOpcodeClassCount]
+    {
+         -22,   17,    5,   -6,   -1,   -4,   -7,   11,   -3,    1,   -3,  -16
+    };
+
+inline constexpr int8_t kBigramLogOdds[kOpcodeClassCount][kOpcodeClassCount]
+    {
+        {  -7,   12,    6,   -2,    7,   -3,    4,    8,    6,    5,    1,    1},  // After Illegal
+        { -20,    8,   10,    6,   -1,   -5,   -1,    4,  -10,    0,   -6,  -10},  // After Load
+        { -13,   11,    3,   -1,    1,   -7,    1,    9,    1,    1,   -1,   -5},  // After Store
+        {  -9,    5,   13,   -8,    2,   -4,    9,    1,    2,    1,    5,   -2},  // After Arithmetic
+        {  -6,    5,    5,   -2,   -8,   -2,    7,    0,    0,    5,   -2,   -5},  // After Compare
+        { -11,   16,    7,   -1,    9,   -3,   10,    2,   -3,    1,   -3,  -11},  // After Modify
+        {  -7,    9,    9,    4,   -1,    0,   -5,   13,    0,    4,   -1,   -4},  // After Branch
+        { -15,   13,   -2,   -3,   -4,    0,   10,    4,  -10,   -8,    1,  -14},  // After Jump
+        {  -3,   10,   10,    1,    3,   -1,    1,    1,   -5,   10,    5,   -1},  // After Return
+        { -10,   13,    4,   -1,    4,   -5,    0,    4,    2,    1,   -2,   -2},  // After Transfer
+        {  -9,   20,    4,    8,    8,    1,   -6,    5,   13,    4,  -13,   -8},  // After Flag
+        {  -2,   16,   16,    8,    8,   -2,    6,    9,    5,    9,   -1,   -8}   // After Break
+    };
+
+inline constexpr int8_t kTrigramLogOdds[kOpcodeClassCount][kOpcodeClassCount][kOpcodeClassCount]
+    {
+        {   // After Illegal, then:
+            {  -8,    9,    5,   -2,    5,    0,    4,    9,    9,    5,    2,    2},  // Illegal
+            {  -3,    1,    1,    1,   -3,    1,    1,    1,    1,    1,    1,    1},  // Load
+            {  -6,    4,   -3,    0,    4,    0,    4,    4,    4,    4,    4,    0},  // Store
+            {  -6,    6,    6,   -4,    6,   -1,    3,    2,    4,    4,   11,    1},  // Arithmetic
+            {  -2,    3,    3,    3,   -4,   -2,   -4,    3,    3,    3,    3,    3},  // Compare
+            {  -5,    7,    7,    2,   11,   -4,    1,   11,    3,    7,    0,   -2},  // Modify
+            {  -6,    6,    6,    6,   -2,    1,   -1,    6,    1,    1,    6,    1},  // Branch
+            {  -5,    3,    3,   -3,    3,    3,    3,    3,    3,    3,    3,   -3},  // Jump
+            {  -4,    4,    4,    0,    0,    4,    4,    0,   -5,    4,    4,    4},  // Return
+            {  -5,    5,    0,   -3,    5,   -3,    0,    5,    5,    5,    5,    0},  // Transfer
+            {  -4,    8,    4,    8,    8,    8,   -5,    8,    8,    8,   -3,   -4},  // Flag
+            {   4,    8,    8,    8,    8,    4,    8,    4,    2,    8,    4,   -9}   // Break
+        },
+        {   // After Load, then:
+            {  -2,    2,    2,    2,   -2,   -4,   -2,    2,    2,    2,    2,    2},  // Illegal
+            { -15,    0,    6,    2,   -1,   -3,   -1,    3,   -8,   -6,   -4,  -15},  // Load
+            { -18,    7,    1,   -3,  -11,    1,   -5,    3,   -1,   -5,   -4,  -18},  // Store
+            { -15,  -15,    6,   -1,   -4,   -8,    6,   -7,   -4,   -7,   -6,  -10},  // Arithmetic
+            { -16,  -11,  -11,  -11,  -11,  -11,   10,  -11,  -11,  -11,  -11,  -11},  // Compare
+            { -12,   -2,    2,   -8,   -2,    4,    8,   -8,   -8,    0,   -4,   -8},  // Modify
+            { -13,    8,   -2,   -3,   -1,    2,   -8,    3,   -6,   -4,   -3,  -13},  // Branch
+            { -12,    6,   -2,   -4,   -7,   -1,    1,    4,    0,   -7,   -4,   -7},  // Jump
+            {   1,    1,    1,    1,    1,    1,   -4,    1,    1,    1,    1,    1},  // Return
+            {  -8,    5,    2,   -8,   -8,    0,   -3,    4,   -1,    0,   -3,   -8},  // Transfer
+            {  -7,    2,   -7,    4,   -7,   -3,   -1,   -7,   -3,   -3,   -1,   -7},  // Flag
+            {   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0}   // Break
+        },
+        {   // After Store, then:
+            {  -6,    5,    1,   -5,    5,    5,    5,    5,    5,    1,    1,    5},  // Illegal
+            { -17,    3,    7,    1,   -4,   -4,   -1,   -1,   -8,   -7,   -8,  -17},  // Load
+            { -17,   10,    5,   -9,   -9,   -2,   -4,    3,    2,   -3,   -7,   -9},  // Store
+            { -10,   -5,    6,   -5,   -5,   -5,    9,   -5,   -5,   -5,   -5,  -10},  // Arithmetic
+            {  -4,   -4,   -4,   -4,   -4,   -4,    7,   -4,    3,   -4,   -4,   -4},  // Compare
+            { -15,    1,  -10,  -10,    0,    4,   10,   -3,   -6,  -10,  -10,  -10},  // Modify
+            {  -8,    6,   -4,   -4,    1,    1,   -8,    2,   -2,   -4,   -4,   -2},  // Branch
+            { -12,    5,   -3,   -3,  -12,    0,    4,    2,    0,   -7,   -4,  -12},  // Jump
+            {  -1,    4,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1},  // Return
+            { -11,    2,    5,    0,   -2,   -2,    0,   -2,    2,    2,    2,   -6},  // Transfer
+            { -10,    7,   -6,    0,   -6,   -6,   -6,   -1,    5,   -1,   -1,   -6},  // Flag
+            {   1,    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,   -4}   // Break
+        },
+        {   // After Arithmetic, then:
+            {  -7,   10,    3,   -4,   10,   -1,    3,    3,    5,    5,    5,   10},  // Illegal
+            {  -2,   -2,    6,   -2,    5,   -2,   -2,   -2,   -2,   -2,   -6,   -2},  // Load
+            { -12,    7,   -5,   -6,   -8,    2,    2,    1,    2,   -5,   -3,  -12},  // Store
+            { -12,    2,   15,   -6,    2,   -7,    5,    1,    2,    2,    2,   -4},  // Arithmetic
+            {  -6,   -2,   -2,   -6,   -2,   -2,    5,   -2,   -2,   -2,   -2,   -2},  // Compare
+            { -10,    2,    5,   -3,    2,   -6,   11,    2,    2,   -3,   -3,   -3},  // Modify
+            { -16,    8,    0,    0,   -9,    0,    1,    5,    0,  -11,   -4,   -7},  // Branch
+            {  -9,    7,   -2,   -6,   -2,    5,    3,    3,   -2,   -2,    3,   -2},  // Jump
+            {  -3,    2,    2,   -3,    2,    2,   -3,    2,    2,    2,    2,    2},  // Return
+            { -13,    7,   -4,    3,    2,    2,   -4,    3,    0,    4,   -4,   -4},  // Transfer
+            {  -7,   -2,   -2,    8,   -2,   -2,   -2,   -2,   -2,   -2,   -2,   -2},  // Flag
+            {  -5,    7,    3,   -1,    3,   -1,    3,    3,    3,    3,    3,   -6}   // Break
+        },
+        {   // After Compare, then:
+            {  -6,    3,    3,   -1,    3,    3,   -1,    3,    3,    3,    3,    3},  // Illegal
+            {   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0},  // Load
+            {   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0},  // Store
+            {   1,    1,    1,   -3,    1,   -3,    1,    1,    1,    1,    1,    1},  // Arithmetic
+            {  -2,    4,    4,    4,   -4,    4,    0,    4,    4,    4,    0,   -4},  // Compare
+            {   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0},  // Modify
+            { -20,    9,    0,   -6,    3,    3,    0,    4,   -2,   -9,   -1,  -12},  // Branch
+            {   1,    1,    1,   -4,    1,    1,    1,    1,    1,    1,    1,    1},  // Jump
+            {   1,    1,    1,    1,   -4,    1,    1,    1,    1,    1,    1,    1},  // Return
+            {   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0},  // Transfer
+            {  -6,    1,    1,    1,    1,    1,    5,    1,    1,    1,    1,    1},  // Flag
+            {   3,    3,    3,    3,   -2,    3,    3,    3,    3,    3,    3,   -7}   // Break
+        },
+        {   // After Modify, then:
+            {  -5,   10,    2,    1,    6,   -3,    1,    6,    4,    2,    1,   -3},  // Illegal
+            { -13,    2,    4,    1,    6,   -4,    1,   -4,   -1,   -8,   -2,   -8},  // Load
+            {  -5,    8,   -5,   -5,   -5,   -2,    3,    4,   -1,   -5,   -5,   -9},  // Store
+            {  -7,    0,    6,   -4,    0,    0,    0,    0,    4,    7,   -5,    0},  // Arithmetic
+            {  -6,   -6,   -6,   -6,   -6,   -6,    9,   -6,   -6,   -6,   -6,   -6},  // Compare
+            { -14,   11,    9,    9,    6,    1,   11,    7,    0,    2,   -5,  -17},  // Modify
+            { -19,    9,   -1,   -1,   -9,    2,   -1,    5,    6,   -1,   -3,  -11},  // Branch
+            {  -3,    8,   -3,   -3,   -3,    2,    2,    5,   -3,   -3,   -3,  -10},  // Jump
+            {   0,    4,    4,    4,    4,    0,    0,    4,   -7,    4,    4,    4},  // Return
+            {  -1,    4,   -1,   -1,   -1,   -1,   -1,    4,    4,   -1,   -5,   -1},  // Transfer
+            {  -7,    4,    4,   14,    4,    4,   -7,    8,    4,    4,   -7,   -9},  // Flag
+            {  -2,   10,   10,   10,   10,    0,   10,   10,    1,    3,    0,   -4}   // Break
+        },
+        {   // After Branch, then:
+            {  -5,    7,    7,   -3,    7,   -3,    2,    2,    2,    2,    0,    7},  // Illegal
+            { -16,    3,    7,    4,    1,   -3,   -1,    0,   -9,   -5,   -3,  -16},  // Load
+            {  -9,    4,    1,   -5,   -2,    6,   -5,    0,   -5,   -3,   -5,   -9},  // Store
+            { -10,    1,   -1,   -1,   -1,   -1,    8,    1,   -6,   -6,   -1,   -6},  // Arithmetic
+            { -13,   -6,   -6,   -6,  -11,   -6,   11,   -6,   -6,   -6,   -2,   -6},  // Compare
+            { -14,    6,    0,   -5,    1,   -4,    3,    4,   -1,   -9,   -2,   -5},  // Modify
+            { -13,    9,   11,   -5,    3,   -5,   -5,    5,    2,    0,   -5,  -14},  // Branch
+            { -12,    5,   -1,   -4,   -7,   -2,    1,    5,   -2,   -5,   -2,  -12},  // Jump
+            {   2,    2,    2,   -2,   -2,    2,    2,    2,   -2,    2,    2,   -2},  // Return
+            {  -5,    5,    4,   -9,    2,   -1,   -1,    2,   -5,   -5,    2,   -5},  // Transfer
+            {  -9,    7,   -5,    5,   -5,   -1,    4,    5,    5,   -5,  -14,   -1},  // Flag
+            {  -3,    3,    3,    3,    3,    3,    3,    3,    3,    3,    3,   -4}   // Break
+        },
+        {   // After Jump, then:
+            {  -6,    3,    3,   -4,    3,    3,    3,    3,    3,    3,    3,    3},  // Illegal
+            { -14,    2,    6,    2,   -2,   -6,    1,    0,   -7,   -6,   -4,  -14},  // Load
+            { -10,    7,    1,   -5,    1,   -5,    1,    3,   -5,   -1,   -1,   -5},  // Store
+            { -10,   -3,    1,   -8,   -3,   -3,    6,   -3,    1,   -3,   -3,   -3},  // Arithmetic
+            {  -1,   -1,   -1,   -1,   -1,   -1,    5,   -1,   -1,   -1,   -1,   -1},  // Compare
+            {  -6,   -2,   -2,   -6,    1,    5,    8,   -2,   -2,   -6,   -6,  -13},  // Modify
+            { -11,    6,  -11,   -6,   -4,    1,   -3,    5,    0,   -3,   -4,  -11},  // Branch
+            { -10,    6,   -6,   -6,  -10,   -6,    2,    8,    0,   -6,   -6,  -17},  // Jump
+            {   1,    1,    1,    1,    1,    1,    1,   -3,    1,    1,    1,   -3},  // Return
+            {  -8,   -4,    1,    3,    4,   -4,    1,   -4,    3,    4,   -4,   -4},  // Transfer
+            {  -5,    6,   -5,    4,   -5,   -5,   -5,   -5,    4,   -5,   -5,   -5},  // Flag
+            {  -4,    2,    2,    2,    2,   -2,    2,    2,   -2,    2,   -2,    2}   // Break
+        },
+        {   // After Return, then:
+            {   0,    5,    5,    5,    5,   -7,    5,    5,   -2,    5,    5,   -2},  // Illegal
+            {  -1,   -1,   -1,    4,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1},  // Load
+            {   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0},  // Store
+            {  -4,    2,    2,    2,    2,    2,    2,    2,    2,   -2,    2,   -2},  // Arithmetic
+            {   1,    1,    1,    1,   -3,    1,    1,    1,    1,    1,    1,   -3},  // Compare
+            {  -3,    3,    3,    3,    3,   -3,    3,    3,    3,    3,   -1,   -4},  // Modify
+            {  -6,    2,    2,    2,    2,    2,   -2,    2,    2,    2,    2,    2},  // Branch
+            {  -4,    2,    2,    2,    2,   -2,    2,    2,   -2,    2,    2,    2},  // Jump
+            {  -2,    6,    6,    6,    2,   -3,    2,    2,   -4,    6,    6,   -4},  // Return
+            {   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0},  // Transfer
+            {   1,    1,    1,    1,    1,    1,    1,    1,   -4,    1,    1,    1},  // Flag
+            {   3,    3,    3,    3,    3,    3,    3,   -1,   -1,    3,    3,   -7}   // Break
+        },
+        {   // After Transfer, then:
+            {  -6,    5,    5,   -4,    5,    1,    5,    5,    1,    1,    5,    1},  // Illegal
+            {  -8,   -8,    4,    2,   -3,   -1,    1,   -3,   -1,    4,   -1,   -8},  // Load
+            {  -6,    3,    2,  -10,   -6,    4,   -6,    4,   -1,    1,    1,   -6},  // Store
+            { -10,   -2,    2,    4,   -2,    2,    7,    2,   -2,    6,   -2,   -9},  // Arithmetic
+            {  -3,   -3,   -3,   -3,   -3,   -3,    8,   -3,   -3,   -3,   -3,   -3},  // Compare
+            {  -9,    2,    0,    2,   -2,    7,    2,   -2,   -2,   -2,    2,   -2},  // Modify
+            {  -2,    2,   -2,   -2,   -2,    3,   -2,    3,   -2,   -2,   -2,   -2},  // Branch
+            {  -5,    3,   -1,   -5,   -5,    1,   -1,    1,   -1,    5,   -5,   -5},  // Jump
+            {   1,    1,    1,   -3,    1,    1,   -3,    1,    1,    1,    1,    1},  // Return
+            {  -6,    6,    4,    6,   -2,    4,   -2,    6,    7,   -3,    4,   -2},  // Transfer
+            {  -2,   -2,   -2,    4,   -2,   -2,   -2,    2,    2,   -2,   -7,   -2},  // Flag
+            {   1,    1,    1,    1,    1,    1,   -3,    1,    1,    1,   -3,    1}   // Break
+        },
+        {   // After Flag, then:
+            {  -5,    8,    8,    2,    8,   -6,    4,    8,    8,    4,    2,    0},  // Illegal
+            {  -9,    0,    2,    8,   -9,   -4,   -2,   -9,   -9,   -2,   -9,   -9},  // Load
+            {  -4,    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,    1},  // Store
+            { -13,   -2,    6,   -2,   -8,   -4,    4,    0,   -2,    5,   -2,   -8},  // Arithmetic
+            {   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0},  // Compare
+            {  -3,    1,    6,    1,    1,    1,    6,    1,   -3,    1,   -2,   -6},  // Modify
+            {  -6,    6,    2,    2,   -2,    1,   -2,    6,   -4,    6,    9,   -8},  // Branch
+            {  -1,    4,   -1,   -1,   -1,    4,   -1,   -1,   -1,    4,    4,   -7},  // Jump
+            {   1,    1,    1,    1,    1,   -3,    1,    1,    1,    1,   -3,    1},  // Return
+            {  -1,   -1,   -1,    6,   -1,   -1,   -1,   -1,   -1,   -1,   -1,   -5},  // Transfer
+            {  -2,   18,   10,   10,   10,   -1,    2,    5,   10,    5,   -9,   -4},  // Flag
+            {   7,    7,    7,    7,    7,    7,    7,    7,    7,    7,   -3,   -9}   // Break
+        },
+        {   // After Break, then:
+            {  -5,    9,    9,    2,    4,   -6,    4,    9,    1,    4,    9,    4},  // Illegal
+            {  -1,   -1,   -1,    4,   -1,    4,   -1,   -1,   -1,   -1,   -5,   -1},  // Load
+            {   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0},  // Store
+            {  -3,    1,    1,   -5,    1,    1,    5,    1,    1,    1,    1,    1},  // Arithmetic
+            {  -3,    1,    1,    1,    1,    1,   -3,    1,    1,    1,    1,    1},  // Compare
+            {  -4,   11,    7,    7,    7,   -8,    7,    7,   -1,    7,   -5,    2},  // Modify
+            {  -3,    2,    2,    2,    2,    2,   -6,    2,    6,    2,   -3,    2},  // Branch
+            {  -3,    1,    1,    1,    1,    1,    1,    1,   -3,    1,    1,    1},  // Jump
+            {   3,    3,    3,    3,    3,    3,   -1,   -1,   -6,    3,    3,    3},  // Return
+            {  -3,    1,    1,    1,    1,    1,    1,    1,    1,    1,   -3,    1},  // Transfer
+            {  -2,    7,    7,    7,    7,    1,    3,    3,    3,    7,   -7,    0},  // Flag
+            {  -6,   12,   12,    8,   12,   -2,    7,   12,    3,    7,   -4,   -2}   // Break
+        }
+    };
+
+}
+
+#endif //HAC65_DARKCODEMODEL_HPP
@@ -0,0 +1,147 @@
+//
+// HAC/65 6502 Inferencing Disassembler
+//
+// This work is licensed under the MIT License <https://opensource.org/licenses/MIT>
+// Copyright 2018 David Hinson <https://github.com/dhinson919>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Portions of this work are derived from the RSA Data Security, Inc. MD5 Message-Digest Algorithm
+//
+
+#ifndef HAC65_DATAPROFILER_HPP
+#define HAC65_DATAPROFILER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "common.hpp"
+
+namespace Hac65
+{
+
+// Profiles a run of octets in one pass.  Printable (ASCII space through tilde) and zero octets are counted a vector at
+// a time with AVX2 or SSE2 where built for, else one at a time.  The histogram behind the entropy is tallied in four
+// interleaved parts so that runs of equal octets don't stall on a single counter:
+inline DataProfile
+ProfileOctets (const Octet *pOctets, size_t count)
+{
+    std::array<std::array<uint32_t, 0x100>, 4> histograms{};
+    size_t printableCount{0};
+    size_t zeroCount{0};
+    size_t offset{0};
+
+#if defined(__AVX2__)
+    {
+        const __m256i spaceBefore{_mm256_set1_epi8(' ' - 1)};
+        const __m256i tildeAfter{_mm256_set1_epi8('~' + 1)};
+        const __m256i zeros{_mm256_setzero_si256()};
+        for (; offset + 32 <= count; offset += 32)
+        {
+            // Octets from $80 compare as negative, so are never printable:
+            const __m256i octets{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(pOctets + offset))};
+            const __m256i isPrintable{
+                _mm256_and_si256(_mm256_cmpgt_epi8(octets, spaceBefore), _mm256_cmpgt_epi8(tildeAfter, octets))};
+            printableCount += __builtin_popcount(static_cast<uint32_t>(_mm256_movemask_epi8(isPrintable)));
+            zeroCount += __builtin_popcount(
+                static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(octets, zeros))));
+        }
+    }
+#elif defined(__SSE2__)
+    {
+        const __m128i spaceBefore{_mm_set1_epi8(' ' - 1)};
+        const __m128i tildeAfter{_mm_set1_epi8('~' + 1)};
+        const __m128i zeros{_mm_setzero_si128()};
+        for (; offset + 16 <= count; offset += 16)
+        {
+            // Octets from $80 compare as negative, so are never printable:
+            const __m128i octets{_mm_loadu_si128(reinterpret_cast<const __m128i *>(pOctets + offset))};
+            const __m128i isPrintable{
+                _mm_and_si128(_mm_cmpgt_epi8(octets, spaceBefore), _mm_cmplt_epi8(octets, tildeAfter))};
+            printableCount += __builtin_popcount(static_cast<uint32_t>(_mm_movemask_epi8(isPrintable)));
+            zeroCount += __builtin_popcount(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(octets, zeros))));
+        }
+    }
+#endif
+
+    for (; offset < count; ++offset)
+    {
+        printableCount += (pOctets[offset] >= ' ' && pOctets[offset] <= '~') ? 1 : 0;
+        zeroCount += (pOctets[offset] == 0) ? 1 : 0;
+    }
+
+    size_t position{0};
+    for (; position + 4 <= count; position += 4)
+    {
+        ++histograms[0][pOctets[position]];
+        ++histograms[1][pOctets[position + 1]];
+        ++histograms[2][pOctets[position + 2]];
+        ++histograms[3][pOctets[position + 3]];
+    }
+    for (; position < count; ++position)
+        ++histograms[0][pOctets[position]];
+
+    double entropy{0.0};
+    uint32_t maxFrequency{0};
+    for (size_t octet{0}; octet < 0x100; ++octet)
+    {
+        const uint32_t frequency{
+            histograms[0][octet] + histograms[1][octet] + histograms[2][octet] + histograms[3][octet]};
+        if (frequency != 0)
+        {
+            const double probability{static_cast<double>(frequency) / count};
+            entropy -= probability * std::log2(probability);
+        }
+        maxFrequency = std::max(maxFrequency, frequency);
+    }
+
+    DataProfile result{
+        DataProfile::DK__Unknown,
+        static_cast<float>(entropy),
+        static_cast<uint8_t>((count == 0) ? 0 : 100 * printableCount / count),
+        static_cast<uint8_t>((count == 0) ? 0 : 100 * zeroCount / count)};
+
+    // Entropy can reach no more than the log of the octet count, so high entropy is judged against that.  Character
+    // sets are glyphs of eight octets given largely to blank rows:
+    static constexpr size_t kMinTextCount{4};
+    static constexpr size_t kMinCharacterSetCount{64};
+    static constexpr size_t kMinCompressedCount{64};
+    const double maxEntropy{std::log2(static_cast<double>(std::min<size_t>(std::max<size_t>(count, 2), 0x100)))};
+    if (count == 0)
+        return result;
+    if (maxFrequency * 10 >= count * 9)
+        result._kind = DataProfile::DK_Fill;
+    else if (count >= kMinTextCount && result._printablePercent >= 85)
+        result._kind = DataProfile::DK_Text;
+    else if (count >= kMinCharacterSetCount && result._zeroPercent >= 25 && entropy <= 5.0)
+        result._kind = DataProfile::DK_CharacterSet;
+    else if (count >= kMinCompressedCount && entropy >= 0.95 * maxEntropy)
+        result._kind = DataProfile::DK_Compressed;
+    else
+        result._kind = DataProfile::DK_Table;
+    return result;
+}
+
+}
+
+#endif //HAC65_DATAPROFILER_HPP
@@ -0,0 +1,393 @@
+//
+// HAC/65 6502 Inferencing Disassembler
+//
+// This work is licensed under the MIT License <https://opensource.org/licenses/MIT>
+// Copyright 2018 David Hinson <https://github.com/dhinson919>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Portions of this work are derived from the RSA Data Security, Inc. MD5 Message-Digest Algorithm
+//
+
+#ifndef HAC65_DECODETABLE_HPP
+#define HAC65_DECODETABLE_HPP
+
+#include <array>
+#include <utility>
+
+#include "common.hpp"
+
+namespace Hac65
+{
+
+// How an instruction affects the program counter:
+enum FlowClass : Octet
+{
+    FC__Unknown,
+    FC_None,
+    FC_Branch,
+    FC_Jump,
+    FC_Call,
+    FC_Return,
+    FC_Break
+};
+
+// Cycles an instruction may take beyond its base count:
+enum CyclePenalty : Octet
+{
+    CP__Unknown,
+    CP_None,
+    CP_Branch,      // One more if taken, another if landing on a page other than the next instruction's
+    CP_PageCross    // One more if indexing crosses out of the base address's page
+};
+
+struct DecodeEntry
+{
+    OpcodeInfo _opcodeInfo;
+    uint8_t _operandSize;
+    FlowClass _flowClass;
+    uint8_t _baseCycles;
+    CyclePenalty _cyclePenalty;
+    bool _isLegal;
+};
+
+inline constexpr std::array<MnemonicInfo, M_TYA + 1> kMnemonicInfos
+    {{
+        {""},
+        {"ADC"}, {"AND"}, {"ASL"}, {"BCC"}, {"BCS"}, {"BEQ"}, {"BNE"}, {"BMI"}, {"BPL"}, {"BVC"},
+        {"BVS"}, {"BIT"}, {"BRK"}, {"CLC"}, {"CLD"}, {"CLI"}, {"CLV"}, {"CMP"}, {"CPX"}, {"CPY"},
+        {"DEC"}, {"DEX"}, {"DEY"}, {"EOR"}, {"INC"}, {"INX"}, {"INY"}, {"JMP"}, {"JSR"}, {"LDA"},
+        {"LDX"}, {"LDY"}, {"LSR"}, {"NOP"}, {"ORA"}, {"PHA"}, {"PHP"}, {"PLA"}, {"PLP"}, {"ROL"},
+        {"ROR"}, {"RTI"}, {"RTS"}, {"SBC"}, {"SEC"}, {"SED"}, {"SEI"}, {"STA"}, {"STX"}, {"STY"},
+        {"TAX"}, {"TAY"}, {"TSX"}, {"TXA"}, {"TXS"}, {"TYA"}
+    }};
+
+inline constexpr std::array<AddressModeInfo, AM_ZeroPageY + 1> kAddressModeInfos
+    {{
+        {0, "", ""},        // AM__Unknown
+        {0, "A", ""},       // AM_Accumulator
+        {2, "", ""},        // AM_Absolute
+        {2, "", ",X"},      // AM_AbsoluteX
+        {2, "", ",Y"},      // AM_AbsoluteY
+        {1, "#", ""},       // AM_Immediate
+        {0, "", ""},        // AM_Implied
+        {2, "(", ")"},      // AM_Indirect
+        {1, "(", ",X)"},    // AM_IndirectX
+        {1, "(", "),Y"},    // AM_IndirectY
+        {1, "", ""},        // AM_Relative
+        {1, "", ""},        // AM_ZeroPage
+        {1, "", ",X"},      // AM_ZeroPageX
+        {1, "", ",Y"}       // AM_ZeroPageY
+    }};
+
+inline constexpr std::pair<Opcode, OpcodeInfo> kLegalOpcodeInfos[]
+    {
+        {0x69, {M_ADC, AM_Immediate, MO_None}},
+        {0x6d, {M_ADC, AM_Absolute, MO_Read}},
+        {0x65, {M_ADC, AM_ZeroPage, MO_Read}},
+        {0x61, {M_ADC, AM_IndirectX, MO_Read}},
+        {0x71, {M_ADC, AM_IndirectY, MO_Read}},
+        {0x75, {M_ADC, AM_ZeroPageX, MO_Read}},
+        {0x7d, {M_ADC, AM_AbsoluteX, MO_Read}},
+        {0x79, {M_ADC, AM_AbsoluteY, MO_Read}},
+        {0x29, {M_AND, AM_Immediate, MO_None}},
+        {0x2d, {M_AND, AM_Absolute, MO_Read}},
+        {0x25, {M_AND, AM_ZeroPage, MO_Read}},
+        {0x21, {M_AND, AM_IndirectX, MO_Read}},
+        {0x31, {M_AND, AM_IndirectY, MO_Read}},
+        {0x35, {M_AND, AM_ZeroPageX, MO_Read}},
+        {0x3d, {M_AND, AM_AbsoluteX, MO_Read}},
+        {0x39, {M_AND, AM_AbsoluteY, MO_Read}},
+        {0x0e, {M_ASL, AM_Absolute, MO_Both}},
+        {0x06, {M_ASL, AM_ZeroPage, MO_Both}},
+        {0x0a, {M_ASL, AM_Accumulator, MO_None}},
+        {0x16, {M_ASL, AM_ZeroPageX, MO_Both}},
+        {0x1e, {M_ASL, AM_AbsoluteX, MO_Both}},
+        {0x90, {M_BCC, AM_Relative, MO_None}},
+        {0xb0, {M_BCS, AM_Relative, MO_None}},
+        {0xf0, {M_BEQ, AM_Relative, MO_None}},
+        {0xd0, {M_BNE, AM_Relative, MO_None}},
+        {0x30, {M_BMI, AM_Relative, MO_None}},
+        {0x10, {M_BPL, AM_Relative, MO_None}},
+        {0x50, {M_BVC, AM_Relative, MO_None}},
+        {0x70, {M_BVS, AM_Relative, MO_None}},
+        {0x2c, {M_BIT, AM_Absolute, MO_Read}},
+        {0x24, {M_BIT, AM_ZeroPage, MO_Read}},
+        {0x00, {M_BRK, AM_Implied, MO_None}},
+        {0x18, {M_CLC, AM_Implied, MO_None}},
+        {0xd8, {M_CLD, AM_Implied, MO_None}},
+        {0x58, {M_CLI, AM_Implied, MO_None}},
+        {0xb8, {M_CLV, AM_Implied, MO_None}},
+        {0xc9, {M_CMP, AM_Immediate, MO_None}},
+        {0xcd, {M_CMP, AM_Absolute, MO_Read}},
+        {0xc5, {M_CMP, AM_ZeroPage, MO_Read}},
+        {0xc1, {M_CMP, AM_IndirectX, MO_Read}},
+        {0xd1, {M_CMP, AM_IndirectY, MO_Read}},
+        {0xd5, {M_CMP, AM_ZeroPageX, MO_Read}},
+        {0xdd, {M_CMP, AM_AbsoluteX, MO_Read}},
+        {0xd9, {M_CMP, AM_AbsoluteY, MO_Read}},
+        {0xe0, {M_CPX, AM_Immediate, MO_None}},
+        {0xec, {M_CPX, AM_Absolute, MO_Read}},
+        {0xe4, {M_CPX, AM_ZeroPage, MO_Read}},
+        {0xc0, {M_CPY, AM_Immediate, MO_None}},
+        {0xcc, {M_CPY, AM_Absolute, MO_Read}},
+        {0xc4, {M_CPY, AM_ZeroPage, MO_Read}},
+        {0xce, {M_DEC, AM_Absolute, MO_Both}},
+        {0xc6, {M_DEC, AM_ZeroPage, MO_Both}},
+        {0xd6, {M_DEC, AM_ZeroPageX, MO_Both}},
+        {0xde, {M_DEC, AM_AbsoluteX, MO_Both}},
+        {0xca, {M_DEX, AM_Implied, MO_None}},
+        {0x88, {M_DEY, AM_Implied, MO_None}},
+        {0x49, {M_EOR, AM_Immediate, MO_None}},
+        {0x4d, {M_EOR, AM_Absolute, MO_Read}},
+        {0x45, {M_EOR, AM_ZeroPage, MO_Read}},
+        {0x41, {M_EOR, AM_IndirectX, MO_Read}},
+        {0x51, {M_EOR, AM_IndirectY, MO_Read}},
+        {0x55, {M_EOR, AM_ZeroPageX, MO_Read}},
+        {0x5d, {M_EOR, AM_AbsoluteX, MO_Read}},
+        {0x59, {M_EOR, AM_AbsoluteY, MO_Read}},
+        {0xee, {M_INC, AM_Absolute, MO_Both}},
+        {0xe6, {M_INC, AM_ZeroPage, MO_Both}},
+        {0xf6, {M_INC, AM_ZeroPageX, MO_Both}},
+        {0xfe, {M_INC, AM_AbsoluteX, MO_Both}},
+        {0xe8, {M_INX, AM_Implied, MO_None}},
+        {0xc8, {M_INY, AM_Implied, MO_None}},
+        {OpcodeInfo::JMP_Absolute, {M_JMP, AM_Absolute, MO_None}},
+        {0x6c, {M_JMP, AM_Indirect, MO_None}},
+        {0x20, {M_JSR, AM_Absolute, MO_None}},
+        {0xa9, {M_LDA, AM_Immediate, MO_None}},
+        {0xad, {M_LDA, AM_Absolute, MO_Read}},
+        {0xa5, {M_LDA, AM_ZeroPage, MO_Read}},
+        {0xa1, {M_LDA, AM_IndirectX, MO_Read}},
+        {0xb1, {M_LDA, AM_IndirectY, MO_Read}},
+        {0xb5, {M_LDA, AM_ZeroPageX, MO_Read}},
+        {0xbd, {M_LDA, AM_AbsoluteX, MO_Read}},
+        {0xb9, {M_LDA, AM_AbsoluteY, MO_Read}},
+        {0xa2, {M_LDX, AM_Immediate, MO_None}},
+        {0xae, {M_LDX, AM_Absolute, MO_Read}},
+        {0xa6, {M_LDX, AM_ZeroPage, MO_Read}},
+        {0xbe, {M_LDX, AM_AbsoluteY, MO_Read}},
+        {0xb6, {M_LDX, AM_ZeroPageY, MO_Read}},
+        {0xa0, {M_LDY, AM_Immediate, MO_None}},
+        {0xac, {M_LDY, AM_Absolute, MO_Read}},
+        {0xa4, {M_LDY, AM_ZeroPage, MO_Read}},
+        {0xb4, {M_LDY, AM_ZeroPageX, MO_Read}},
+        {0xbc, {M_LDY, AM_AbsoluteX, MO_Read}},
+        {0x4e, {M_LSR, AM_Absolute, MO_Both}},
+        {0x46, {M_LSR, AM_ZeroPage, MO_Both}},
+        {0x4a, {M_LSR, AM_Accumulator, MO_None}},
+        {0x56, {M_LSR, AM_ZeroPageX, MO_Both}},
+        {0x5e, {M_LSR, AM_AbsoluteX, MO_Both}},
+        {0xea, {M_NOP, AM_Implied, MO_None}},
+        {0x09, {M_ORA, AM_Immediate, MO_None}},
+        {0x0d, {M_ORA, AM_Absolute, MO_Read}},
+        {0x05, {M_ORA, AM_ZeroPage, MO_Read}},
+        {0x01, {M_ORA, AM_IndirectX, MO_Read}},
+        {0x11, {M_ORA, AM_IndirectY, MO_Read}},
+        {0x15, {M_ORA, AM_ZeroPageX, MO_Read}},
+        {0x1d, {M_ORA, AM_AbsoluteX, MO_Read}},
+        {0x19, {M_ORA, AM_AbsoluteY, MO_Read}},
+        {0x48, {M_PHA, AM_Implied, MO_None}},
+        {0x08, {M_PHP, AM_Implied, MO_None}},
+        {0x68, {M_PLA, AM_Implied, MO_None}},
+        {0x28, {M_PLP, AM_Implied, MO_None}},
+        {0x2e, {M_ROL, AM_Absolute, MO_Both}},
+        {0x26, {M_ROL, AM_ZeroPage, MO_Both}},
+        {0x2a, {M_ROL, AM_Accumulator, MO_None}},
+        {0x36, {M_ROL, AM_ZeroPageX, MO_Both}},
+        {0x3e, {M_ROL, AM_AbsoluteX, MO_Both}},
+        {0x6e, {M_ROR, AM_Absolute, MO_Both}},
+        {0x66, {M_ROR, AM_ZeroPage, MO_Both}},
+        {0x6a, {M_ROR, AM_Accumulator, MO_None}},
+        {0x76, {M_ROR, AM_ZeroPageX, MO_Both}},
+        {0x7e, {M_ROR, AM_AbsoluteX, MO_Both}},
+        {0x40, {M_RTI, AM_Implied, MO_None}},
+        {0x60, {M_RTS, AM_Implied, MO_None}},
+        {0xe9, {M_SBC, AM_Immediate, MO_None}},
+        {0xed, {M_SBC, AM_Absolute, MO_Read}},
+        {0xe5, {M_SBC, AM_ZeroPage, MO_Read}},
+        {0xe1, {M_SBC, AM_IndirectX, MO_Read}},
+        {0xf1, {M_SBC, AM_IndirectY, MO_Read}},
+        {0xf5, {M_SBC, AM_ZeroPageX, MO_Read}},
+        {0xfd, {M_SBC, AM_AbsoluteX, MO_Read}},
+        {0xf9, {M_SBC, AM_AbsoluteY, MO_Read}},
+        {0x38, {M_SEC, AM_Implied, MO_None}},
+        {0xf8, {M_SED, AM_Implied, MO_None}},
+        {0x78, {M_SEI, AM_Implied, MO_None}},
+        {0x8d, {M_STA, AM_Absolute, MO_Write}},
+        {0x85, {M_STA, AM_ZeroPage, MO_Write}},
+        {0x81, {M_STA, AM_IndirectX, MO_Write}},
+        {0x91, {M_STA, AM_IndirectY, MO_Write}},
+        {0x95, {M_STA, AM_ZeroPageX, MO_Write}},
+        {0x9d, {M_STA, AM_AbsoluteX, MO_Write}},
+        {0x99, {M_STA, AM_AbsoluteY, MO_Write}},
+        {0x8e, {M_STX, AM_Absolute, MO_Write}},
+        {0x86, {M_STX, AM_ZeroPage, MO_Write}},
+        {0x96, {M_STX, AM_ZeroPageY, MO_Write}},
+        {0x8c, {M_STY, AM_Absolute, MO_Write}},
+        {0x84, {M_STY, AM_ZeroPage, MO_Write}},
+        {0x94, {M_STY, AM_ZeroPageX, MO_Write}},
+        {0xaa, {M_TAX, AM_Implied, MO_None}},
+        {0xa8, {M_TAY, AM_Implied, MO_None}},
+        {0xba, {M_TSX, AM_Implied, MO_None}},
+        {0x8a, {M_TXA, AM_Implied, MO_None}},
+        {0x9a, {M_TXS, AM_Implied, MO_None}},
+        {0x98, {M_TYA, AM_Implied, MO_None}}
+    };
+
+constexpr FlowClass
+MnemonicToFlowClass (const Mnemonic &mnemonic)
+{
+    switch (mnemonic)
+    {
+        case M_BCC: case M_BCS: case M_BEQ: case M_BNE: case M_BMI: case M_BPL: case M_BVC: case M_BVS:
+            return FC_Branch;
+        case M_BRK: return FC_Break;
+        case M_JMP: return FC_Jump;
+        case M_JSR: return FC_Call;
+        case M_RTI: case M_RTS: return FC_Return;
+        default: return FC_None;
+    }
+}
+
+// NMOS 6502 timing, which follows from the mnemonic for stack and control instructions and otherwise from the
+// address mode and whether memory is only read, only written or both:
+constexpr uint8_t
+OpcodeInfoToBaseCycles (const OpcodeInfo &opcodeInfo)
+{
+    switch (opcodeInfo._mnemonic)
+    {
+        case M_BRK: return 7;
+        case M_JMP: return (opcodeInfo._addressMode == AM_Indirect) ? 5 : 3;
+        case M_JSR: case M_RTI: case M_RTS: return 6;
+        case M_PHA: case M_PHP: return 3;
+        case M_PLA: case M_PLP: return 4;
+        default: break;
+    }
+
+    const bool isModifying{opcodeInfo._memoryOperation == MO_Both};
+    const bool isWriting{opcodeInfo._memoryOperation == MO_Write};
+    switch (opcodeInfo._addressMode)
+    {
+        case AM_Accumulator: case AM_Immediate: case AM_Implied: case AM_Relative: return 2;
+        case AM_ZeroPage: return isModifying ? 5 : 3;
+        case AM_Absolute: case AM_ZeroPageX: case AM_ZeroPageY: return isModifying ? 6 : 4;
+        case AM_AbsoluteX: case AM_AbsoluteY: return isModifying ? 7 : (isWriting ? 5 : 4);
+        case AM_IndirectX: return 6;
+        case AM_IndirectY: return isWriting ? 6 : 5;
+        default: return 0;
+    }
+}
+
+// Only reads pay for crossing a page; writes and read-modify-writes always take the extra cycle:
+constexpr CyclePenalty
+OpcodeInfoToCyclePenalty (const OpcodeInfo &opcodeInfo)
+{
+    if (MnemonicToFlowClass(opcodeInfo._mnemonic) == FC_Branch)
+        return CP_Branch;
+    if (opcodeInfo._memoryOperation == MO_Read)
+        switch (opcodeInfo._addressMode)
+        {
+            case AM_AbsoluteX: case AM_AbsoluteY: case AM_IndirectY: return CP_PageCross;
+            default: break;
+        }
+    return CP_None;
+}
+
+constexpr std::array<DecodeEntry, 0x100>
+MakeDecodeTable ()
+{
+    std::array<DecodeEntry, 0x100> result{};
+    for (auto &entry: result)
+        entry = {{M__Unknown, AM__Unknown, MO__Unknown}, 0, FC__Unknown, 0, CP__Unknown, false};
+    for (const auto &pair: kLegalOpcodeInfos)
+    {
+        const OpcodeInfo &opcodeInfo{pair.second};
+        result[pair.first] = {
+            opcodeInfo,
+            kAddressModeInfos[opcodeInfo._addressMode]._operandSize,
+            MnemonicToFlowClass(opcodeInfo._mnemonic),
+            OpcodeInfoToBaseCycles(opcodeInfo),
+            OpcodeInfoToCyclePenalty(opcodeInfo),
+            true};
+    }
+    return result;
+}
+
+// Everything needed to decode an instruction, indexed by opcode:
+inline constexpr std::array<DecodeEntry, 0x100> kDecodeTable{MakeDecodeTable()};
+
+constexpr const DecodeEntry &
+LookupDecodeEntry (const Opcode &opcode)
+{
+    return kDecodeTable[opcode];
+}
+
+// Applies the decode table's penalty rule to an instruction at address.  An absolute base at the start of a page can
+// take any index without crossing; an indirect one is unknown until run:
+constexpr CycleRange
+LookupCycleRange (const Address &address, const Instruction &instruction)
+{
+    const DecodeEntry &decodeEntry{kDecodeTable[instruction._opcode]};
+    CycleRange result{decodeEntry._baseCycles, decodeEntry._baseCycles};
+    switch (decodeEntry._cyclePenalty)
+    {
+        case CP_Branch:
+        {
+            const auto nextAddress{static_cast<Address>(address + sizeof(Opcode) + decodeEntry._operandSize)};
+            const auto target{static_cast<Address>(nextAddress + static_cast<int8_t>(instruction._operand))};
+            result._max += ((nextAddress ^ target) & 0xFF00) ? 2 : 1;
+            break;
+        }
+        case CP_PageCross:
+            if (decodeEntry._opcodeInfo._addressMode == AM_IndirectY || (instruction._operand & 0xFF) != 0)
+                ++result._max;
+            break;
+        default:
+            break;
+    }
+    return result;
+}
+
+constexpr const AddressModeInfo &
+LookupAddressModeInfo (const AddressMode &addressMode)
+{
+    return kAddressModeInfos[addressMode];
+}
+
+constexpr const MnemonicInfo &
+LookupMnemonicInfo (const Mnemonic &mnemonic)
+{
+    return kMnemonicInfos[mnemonic];
+}
+
+constexpr const OpcodeInfo &
+LookupOpcodeInfo (const Opcode &opcode)
+{
+    return kDecodeTable[opcode]._opcodeInfo;
+}
+
+inline const OpcodeInfo &
+Instruction::GetOpcodeInfo () const
+{
+    return LookupOpcodeInfo(_opcode);
+}
+
+static_assert(sizeof(Instruction) <= 4, "instructions must stay packed");
+
+static_assert(LookupCycleRange(0xF045, {0xD0, 0xFD})._max == 3, "branches within a page cost one more if taken");
+
+}
+
+#endif //HAC65_DECODETABLE_HPP
@@ -0,0 +1,151 @@
+//
+// HAC/65 6502 Inferencing Disassembler
+//
+// This work is licensed under the MIT License <https://opensource.org/licenses/MIT>
+// Copyright 2018 David Hinson <https://github.com/dhinson919>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Portions of this work are derived from the RSA Data Security, Inc. MD5 Message-Digest Algorithm
+//
+
+#ifndef HAC65_FLOWGRAPH_HPP
+#define HAC65_FLOWGRAPH_HPP
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+#include "common.hpp"
+
+namespace Hac65
+{
+
+// Basic-block control-flow graph in compressed sparse row form.  Blocks are ordered by start address; the successor
+// edges of block n occupy [_successorOffsets[n], _successorOffsets[n + 1]) of _successors, likewise predecessors.
+class FlowGraph
+{
+    std::vector<BasicBlock> _blocks;
+
+    std::vector<uint32_t> _successorOffsets;
+
+    std::vector<FlowEdge> _successors;
+
+    std::vector<uint32_t> _predecessorOffsets;
+
+    std::vector<FlowEdge> _predecessors;
+
+public:
+    // Successors must be added in block order:
+    void
+    AddSuccessor (uint32_t blockIndex, const FlowEdge &edge)
+    {
+        assert(blockIndex < _blocks.size() && blockIndex + 1 >= _successorOffsets.size());
+        while (_successorOffsets.size() <= blockIndex)
+            _successorOffsets.push_back(static_cast<uint32_t>(_successors.size()));
+        _successors.push_back(edge);
+    }
+
+    void
+    Clear ()
+    {
+        _blocks.clear();
+        _successorOffsets.clear();
+        _successors.clear();
+        _predecessorOffsets.clear();
+        _predecessors.clear();
+    }
+
+    // Finds the block containing address, if any:
+    std::optional<uint32_t>
+    FindBlock (const Address &address) const
+    {
+        std::optional<uint32_t> resultOpt;
+        auto itor{std::upper_bound(
+            std::begin(_blocks),
+            std::end(_blocks),
+            address,
+            [] (const Address &value, const BasicBlock &block) { return value < block._startAddress; })};
+        if (itor != std::begin(_blocks) && address <= (--itor)->_endAddress)
+            resultOpt = static_cast<uint32_t>(itor - std::begin(_blocks));
+        return resultOpt;
+    }
+
+    // Finds the block starting at address, if any:
+    std::optional<uint32_t>
+    FindBlockStart (const Address &address) const
+    {
+        std::optional<uint32_t> resultOpt{FindBlock(address)};
+        if (resultOpt && _blocks[*resultOpt]._startAddress != address)
+            resultOpt.reset();
+        return resultOpt;
+    }
+
+    Span<BasicBlock>
+    GetBlocks () const
+    {
+        return {_blocks.data(), _blocks.size()};
+    }
+
+    Span<FlowEdge>
+    GetPredecessors (size_t blockIndex) const
+    {
+        assert(blockIndex < _blocks.size());
+        const auto offset{_predecessorOffsets[blockIndex]};
+        return {_predecessors.data() + offset, _predecessorOffsets[blockIndex + 1] - offset};
+    }
+
+    Span<FlowEdge>
+    GetSuccessors (size_t blockIndex) const
+    {
+        assert(blockIndex < _blocks.size());
+        const auto offset{_successorOffsets[blockIndex]};
+        return {_successors.data() + offset, _successorOffsets[blockIndex + 1] - offset};
+    }
+
+    // Closes the successor rows and derives the predecessor rows from them:
+    void
+    LinkPredecessors ()
+    {
+        while (_successorOffsets.size() <= _blocks.size())
+            _successorOffsets.push_back(static_cast<uint32_t>(_successors.size()));
+
+        _predecessorOffsets.assign(_blocks.size() + 1, 0);
+        for (const auto &edge: _successors)
+            ++_predecessorOffsets[edge._blockIndex + 1];
+        for (size_t blockIndex{0}; blockIndex < _blocks.size(); ++blockIndex)
+            _predecessorOffsets[blockIndex + 1] += _predecessorOffsets[blockIndex];
+
+        _predecessors.resize(_successors.size());
+        auto fillOffsets{_predecessorOffsets};
+        for (uint32_t blockIndex{0}; blockIndex < _blocks.size(); ++blockIndex)
+            for (const auto &edge: GetSuccessors(blockIndex))
+                _predecessors[fillOffsets[edge._blockIndex]++] = {blockIndex, edge._kind};
+    }
+
+    // Replaces the graph with unlinked blocks, which must be ordered by start address:
+    void
+    SetBlocks (std::vector<BasicBlock> blocks)
+    {
+        _blocks = std::move(blocks);
+        _successorOffsets.clear();
+        _successors.clear();
+        _predecessorOffsets.assign(_blocks.size() + 1, 0);
+        _predecessors.clear();
+    }
+};
+
+}
+
+#endif //HAC65_FLOWGRAPH_HPP
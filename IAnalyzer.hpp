@@ -23,23 +23,51 @@
 #ifndef HAC65_IANALYZER_HPP
 #define HAC65_IANALYZER_HPP
 
-#include <map>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <optional>
 #include <string>
 #include <vector>
 
 #include "md5.h"
 
+#include "AddressBitmap.hpp"
+#include "AddressSpace.hpp"
 #include "common.hpp"
 
 namespace Hac65
 {
 
+// Limits on ledge inference; any left unset is unlimited.  Cancellation is requested by setting the flag, which must
+// outlive the analysis:
+struct AnalysisBudget
+{
+    std::optional<size_t> _roundLimitOpt;
+    std::optional<size_t> _instructionLimitOpt;
+    std::optional<std::chrono::steady_clock::time_point> _deadlineOpt;
+    const std::atomic<bool> *_pIsCancelled{nullptr};
+};
+
+struct AnalysisProgress
+{
+    size_t _roundCount;
+    size_t _instructionCount;
+    size_t _landCount;
+    size_t _leapCount;
+};
+
+using ProgressCallback = std::function<void (const AnalysisProgress &progress)>;
+
 struct IAnalyzer
 {
     virtual void
     Analyze () = 0;
 
+    // Cycles taken by the code segment's instructions, each executed once:
+    virtual CycleRange
+    CountCodeSegmentCycles (const Segment &segment) const = 0;
+
     virtual void
     DeclareCodeLabel (const std::string &label, const Address &address) = 0;
 
@@ -49,21 +77,6 @@ struct IAnalyzer
     virtual void
     DeclareEquate (const std::string &equate, const uint16_t &value) = 0;
 
-    virtual void
-    DeclareIndirectVectorTable (const Address &address, uint16_t vectorCount) = 0;
-
-    virtual void
-    DeclareJumpVectorTable (const Address &address, uint16_t vectorCount) = 0;
-
-    virtual void
-    DeclareKeyedIndirectVectorTable (const Address &address, uint16_t vectorCount) = 0;
-
-    virtual void
-    DeclareKeyedIndirectMinusOneVectorTable (const Address &address, uint16_t vectorCount) = 0;
-
-    virtual void
-    DeclareKeyedVectorTable (const Address &address, uint16_t vectorCount) = 0;
-
     virtual bool
     DeclareLand (const Address &address) = 0;
 
@@ -71,16 +84,19 @@ struct IAnalyzer
     DeclareLeap (const Address &address) = 0;
 
     virtual void
-    DeclareMinusOneVectorTable (const Address &address, uint16_t vectorCount) = 0;
+    DeclareOriginAddress (const Address &address) = 0;
 
+    // Declares a table of vectorCount entries laid out as layout:
     virtual void
-    DeclareNormalVectorTable (const Address &address, uint16_t vectorCount) = 0;
+    DeclareTable (const Address &address, uint16_t vectorCount, const TableLayout &layout) = 0;
 
-    virtual void
-    DeclareOriginAddress (const Address &address) = 0;
+    // Finds the instructions referring to address, in address order:
+    virtual Span<CrossReference>
+    FindCrossReferences (const Address &address) const = 0;
 
-    virtual void
-    DeclareSplitVectorTable (const Address &address, uint16_t vectorCount) = 0;
+    // Finds the basic block containing address, if any:
+    virtual std::optional<size_t>
+    FindBasicBlock (const Address &address) const = 0;
 
     virtual MD5
     FingerprintCodeSegment (const Segment &segment) const = 0;
@@ -94,27 +110,99 @@ struct IAnalyzer
     virtual size_t
     GetAssemblySize () const = 0;
 
-    virtual const std::map<Address, Octet> &
+    // Basic blocks of the control-flow graph, ordered by start address:
+    virtual Span<BasicBlock>
+    GetBasicBlocks () const = 0;
+
+    // Subroutine indexes of the subroutines that the one at subroutineIndex of GetSubroutines() calls:
+    virtual Span<uint32_t>
+    GetCallees (size_t subroutineIndex) const = 0;
+
+    // Strongly connected components of the call graph:
+    virtual size_t
+    GetCallComponentCount () const = 0;
+
+    // Addresses referred to by instructions, in address order:
+    virtual Span<Address>
+    GetCrossReferencedAddresses () const = 0;
+
+    // The instructions referring to the address at addressIndex of GetCrossReferencedAddresses(), in address order:
+    virtual Span<CrossReference>
+    GetCrossReferences (size_t addressIndex) const = 0;
+
+    virtual DataView
     GetData () const = 0;
 
-    virtual const std::map<Address, Opcode> &
+    virtual IllegalsView
     GetIllegals () const = 0;
 
-    virtual const std::map<Address, Instruction> &
+    virtual InstructionsView
     GetInstructions () const = 0;
 
+    // Loops counted by X or Y, ordered by start address:
+    virtual Span<Loop>
+    GetLoops () const = 0;
+
     virtual Address
     GetOriginAddress () const = 0;
 
-    virtual const std::map<Address, Segment> &
+    // How far, out of 100, a detected origin address led the next likeliest; empty unless detected:
+    virtual std::optional<uint8_t>
+    GetOriginConfidence () const = 0;
+
+    // Addresses holding pointers for indirect operands:
+    virtual const AddressBitmap &
+    GetPointerAddresses () const = 0;
+
+    // Edges into a basic block, each naming the block it comes from:
+    virtual Span<FlowEdge>
+    GetPredecessors (size_t blockIndex) const = 0;
+
+    // Addresses read by operands, including those read and written:
+    virtual const AddressBitmap &
+    GetReadAddresses () const = 0;
+
+    virtual SegmentsView
     GetSegments () const = 0;
 
+    // Subroutines of the call graph, ordered by entry address:
+    virtual Span<Subroutine>
+    GetSubroutines () const = 0;
+
+    // Edges out of a basic block, each naming the block it goes to:
+    virtual Span<FlowEdge>
+    GetSuccessors (size_t blockIndex) const = 0;
+
+    // Runs of inferred data resembling vector tables, ordered by address, including any applied during inference:
+    virtual Span<TableCandidate>
+    GetTableCandidates () const = 0;
+
+    // Addresses written by operands, including those read and written:
+    virtual const AddressBitmap &
+    GetWrittenAddresses () const = 0;
+
     virtual bool
     HasOriginAddress () const = 0;
 
+    // Whether inference stopped short on exhausting its budget, leaving best-effort results:
+    virtual bool
+    IsPartial () const = 0;
+
     virtual const AddressModeInfo &
     LookupAddressModeInfo (const AddressMode &addressMode) const = 0;
 
+    // Cycles taken by the instruction at address, from not taking to taking every penalty it may incur:
+    virtual CycleRange
+    LookupCycleRange (const Address &address, const Instruction &instruction) const = 0;
+
+    // Confidence out of 100 that the segment starting at address is dark code, if illumination scored it:
+    virtual std::optional<uint8_t>
+    LookupDarkCodeConfidence (const Address &address) const = 0;
+
+    // Octet statistics and likely kind of the inferred data segment starting at address, if any:
+    virtual std::optional<DataProfile>
+    LookupDataProfile (const Address &address) const = 0;
+
     virtual const std::optional<std::vector<std::string>>
     LookupEquate (const uint16_t &value) const = 0;
 
@@ -127,11 +215,38 @@ struct IAnalyzer
     virtual const std::optional<std::string>
     LookupLabel (const Address &address, std::optional<MemoryOperation> memoryOperationOpt) const = 0;
 
+    // Forgets the object, its declarations and analysis so another may be analyzed; modes and job count persist:
+    virtual void
+    Reset () = 0;
+
     virtual void
     SetAssembly (std::vector<Octet> assembly) = 0;
 
+    virtual void
+    SetBudget (const AnalysisBudget &budget) = 0;
+
     virtual void
     SetIlluminatingMode () = 0;
+
+    // Confidence out of 100 an inferred data segment must reach to be illuminated as dark code (default 50):
+    virtual void
+    SetIlluminatingThreshold (uint16_t threshold) = 0;
+
+    virtual void
+    SetJobCount (uint16_t jobCount) = 0;
+
+    // Detects the origin address from the object itself, superseding any declared:
+    virtual void
+    SetOriginDetectingMode () = 0;
+
+    // Declares table candidates scoring at least score (out of 100) as vector tables once inference settles, then
+    // infers on from the lands they supply:
+    virtual void
+    SetTableApplyingScore (uint16_t score) = 0;
+
+    // Called between inference rounds and waves, from the analyzing thread:
+    virtual void
+    SetProgressCallback (ProgressCallback progressCallback) = 0;
 };
 
 }
@@ -43,6 +43,10 @@ struct IReporter
         const std::string &commandText,
         std::ostream &outStream) = 0;
 
+    // Sets the CPU clock loops are timed by, in MHz or as ntsc or pal for the Atari 8-bit computers:
+    virtual void
+    SetClockRate (const std::string &clockText) = 0;
+
     virtual void
     SetReportFlags (std::string reportFlags) = 0;
 };
@@ -135,8 +135,8 @@ Loader::LoadAroJson (const std::string &architecture, const json &aroJson)
                     throw OverlayError(text.str());
                 }
                 const std::string &structureKey{structureItor.key()};
-                auto kind{LookupStructureKind(structureKey)};
-                if (kind != SK__Unknown)
+                const auto layoutOpt{LookupTableLayout(structureKey)};
+                if (layoutOpt)
                 {
                     const auto &tables{structureItor.value()};
                     if (!tables.is_object())
@@ -150,40 +150,7 @@ Loader::LoadAroJson (const std::string &architecture, const json &aroJson)
                         const auto &addressJson{tableItor.key()};
                         Address address{static_cast<Address>(JsonValueToUint16(addressJson))};
                         auto count{JsonValueToUint16(tableItor.value())};
-                        switch (kind)
-                        {
-                            case SK_NormalVectorTable:
-                                _pAnalyzer->DeclareNormalVectorTable(address, count);
-                                break;
-                            case SK_IndirectVectorTable:
-                                _pAnalyzer->DeclareIndirectVectorTable(address, count);
-                                break;
-                            case SK_KeyedVectorTable:
-                                _pAnalyzer->DeclareKeyedVectorTable(address, count);
-                                break;
-                            case SK_KeyedIndirectVectorTable:
-                                _pAnalyzer->DeclareKeyedIndirectVectorTable(address, count);
-                                break;
-                            case SK_KeyedIndirectMinusOneVectorTable:
-                                _pAnalyzer->DeclareKeyedIndirectMinusOneVectorTable(address, count);
-                                break;
-                            case SK_JumpVectorTable:
-                                _pAnalyzer->DeclareJumpVectorTable(address, count);
-                                break;
-                            case SK_MinusOneVectorTable:
-                                _pAnalyzer->DeclareMinusOneVectorTable(address, count);
-                                break;
-                            case SK_SplitVectorTable:
-                                _pAnalyzer->DeclareSplitVectorTable(address, count);
-                                break;
-                            default:
-                                {
-                                    std::ostringstream text;
-                                    text << "unsupported vector table kind: " << kind << std::endl;
-                                    throw OverlayError(text.str());
-                                }
-                                break;
-                        }
+                        _pAnalyzer->DeclareTable(address, count, *layoutOpt);
                     }
                 }
                 else
@@ -194,6 +161,18 @@ Loader::LoadAroJson (const std::string &architecture, const json &aroJson)
                 }
             }
         }
+        else if (topKey == "layouts")
+        {
+            const auto &topValue{topItor.value()};
+            if (!topValue.is_object())
+            {
+                std::ostringstream text;
+                text << "malformed layouts spec: " << topValue << std::endl;
+                throw OverlayError(text.str());
+            }
+            for (auto layoutItor{std::begin(topValue)}; layoutItor != std::end(topValue); ++layoutItor)
+                LoadTableLayout(layoutItor.key(), layoutItor.value());
+        }
         else if (topKey == "expert")
         {
             const auto &topValue{topItor.value()};
@@ -270,6 +249,83 @@ Loader::LoadAroJson (const std::string &architecture, const json &aroJson)
 
 const char *kIncludeDirectiveSyntax{R"(^\@(include)[\s]*["][A-Za-z0-9._-]{1,20}["])"};
 
+void
+Loader::LoadTableLayout (const std::string &name, const json &layoutJson)
+{
+    // Fields left out default to a normal vector table's, the high octet following the low one:
+    if (!layoutJson.is_object())
+    {
+        std::ostringstream text;
+        text << "malformed layout spec: " << layoutJson << std::endl;
+        throw OverlayError(text.str());
+    }
+    TableLayout layout{kNormalTableLayout};
+    std::optional<uint16_t> highOffsetOpt;
+    for (auto fieldItor{std::begin(layoutJson)}; fieldItor != std::end(layoutJson); ++fieldItor)
+    {
+        const auto &fieldKey{fieldItor.key()};
+        const auto &fieldValue{fieldItor.value()};
+        if (fieldKey == "role")
+        {
+            const auto roleItor{fieldValue.is_string() ? kTableRoles.find(fieldValue) : std::end(kTableRoles)};
+            if (roleItor == std::end(kTableRoles))
+            {
+                std::ostringstream text;
+                text << "unknown layout role: " << fieldValue << std::endl;
+                throw OverlayError(text.str());
+            }
+            layout._role = roleItor->second;
+        }
+        else if (fieldKey == "split")
+        {
+            if (!fieldValue.is_boolean())
+            {
+                std::ostringstream text;
+                text << "malformed split value: " << fieldValue << std::endl;
+                throw OverlayError(text.str());
+            }
+            layout._isSplit = fieldValue;
+        }
+        else
+        {
+            const uint16_t value{JsonValueToUint16(fieldValue)};
+            if (value > 0xFF)
+            {
+                std::ostringstream text;
+                text << "layout value out of range: " << fieldKey << ": " << fieldValue << std::endl;
+                throw OverlayError(text.str());
+            }
+            if (fieldKey == "entry_size")
+                layout._entrySize = static_cast<uint8_t>(value);
+            else if (fieldKey == "vector_offset")
+                layout._vectorOffset = static_cast<uint8_t>(value);
+            else if (fieldKey == "high_offset")
+                highOffsetOpt = value;
+            else if (fieldKey == "land_adjust")
+                layout._landAdjust = static_cast<uint8_t>(value);
+            else
+            {
+                std::ostringstream text;
+                text << "unknown layout field: " << fieldKey << std::endl;
+                throw OverlayError(text.str());
+            }
+        }
+    }
+    layout._highOffset = static_cast<uint8_t>(
+        highOffsetOpt.value_or(layout._isSplit ? layout._vectorOffset : layout._vectorOffset + 1));
+
+    if (layout._entrySize == 0 ||
+        layout._vectorOffset >= layout._entrySize ||
+        layout._highOffset >= layout._entrySize ||
+        (layout._role == TableLayout::TR_Jump && layout._entrySize < sizeof(Opcode) + sizeof(Operand)))
+    {
+        std::ostringstream text;
+        text << "inconsistent layout spec: " << name << ": " << layoutJson << std::endl;
+        throw OverlayError(text.str());
+    }
+    _tableLayouts[name] = layout;
+}
+
 void
 Loader::LoadAroStream (std::ifstream &aroStream, const std::string &architecture, int depth)
 {
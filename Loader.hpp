@@ -41,28 +41,24 @@ namespace Hac65
 
 class Loader : public ILoader
 {
-    enum StructureKind
-    {
-        SK__Unknown,
-        SK_NormalVectorTable,
-        SK_IndirectVectorTable,
-        SK_KeyedVectorTable,
-        SK_KeyedIndirectVectorTable,
-        SK_KeyedIndirectMinusOneVectorTable,
-        SK_JumpVectorTable,
-        SK_MinusOneVectorTable,
-        SK_SplitVectorTable
-    };
-    const std::unordered_map<std::string, StructureKind> kStructureKinds
+    const std::unordered_map<std::string, TableLayout::Role> kTableRoles
+        {
+            {"indirect", TableLayout::TR_Indirect},
+            {"jump", TableLayout::TR_Jump},
+            {"vector", TableLayout::TR_Vector}
+        };
+
+    // Table layouts declarable by name in structures, joined by those overlays define under layouts:
+    std::unordered_map<std::string, TableLayout> _tableLayouts
         {
-            {"normal_vector_tables", SK_NormalVectorTable},
-            {"indirect_vector_tables", SK_IndirectVectorTable},
-            {"keyed_vector_tables", SK_KeyedVectorTable},
-            {"keyed_indirect_vector_tables", SK_KeyedIndirectVectorTable},
-            {"keyed_indirect_minus_one_vector_tables", SK_KeyedIndirectMinusOneVectorTable},
-            {"jump_vector_tables", SK_JumpVectorTable},
-            {"minus_one_vector_tables", SK_MinusOneVectorTable},
-            {"split_vector_tables", SK_SplitVectorTable}
+            {"normal_vector_tables", kNormalTableLayout},
+            {"indirect_vector_tables", kIndirectTableLayout},
+            {"keyed_vector_tables", kKeyedTableLayout},
+            {"keyed_indirect_vector_tables", kKeyedIndirectTableLayout},
+            {"keyed_indirect_minus_one_vector_tables", kKeyedIndirectMinusOneTableLayout},
+            {"jump_vector_tables", kJumpTableLayout},
+            {"minus_one_vector_tables", kMinusOneTableLayout},
+            {"split_vector_tables", kSplitTableLayout}
         };
 
     const std::unordered_map<std::string, json> kBuiltinArchitectures
@@ -138,11 +134,14 @@ class Loader : public ILoader
     void
     LoadObjectFile ();
 
-    StructureKind
-    LookupStructureKind (const std::string &key) const
+    void
+    LoadTableLayout (const std::string &name, const json &layoutJson);
+
+    std::optional<TableLayout>
+    LookupTableLayout (const std::string &key) const
     {
-        auto kindItor{kStructureKinds.find(key)};
-        return (kindItor == std::end(kStructureKinds)) ? SK__Unknown : kindItor->second;
+        auto layoutItor{_tableLayouts.find(key)};
+        return (layoutItor == std::end(_tableLayouts)) ? std::nullopt : std::optional<TableLayout>{layoutItor->second};
     }
 
     MD5
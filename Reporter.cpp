@@ -20,7 +20,10 @@
 // Portions of this work are derived from the RSA Data Security, Inc. MD5 Message-Digest Algorithm
 //
 
+#include <algorithm>
+#include <cctype>
 #include <iomanip>
+#include <map>
 #include <set>
 
 #include "Reporter.hpp"
@@ -75,6 +78,41 @@ Reporter::AddressToString (const Address &address, std::optional<Opcode> opcodeO
     return str.str();
 }
 
+std::string
+Reporter::CycleRangeToString (const CycleRange &range) const
+{
+    std::string result{std::to_string(range._min)};
+    if (range._max != range._min)
+        result += '-' + std::to_string(range._max);
+    return result;
+}
+
+std::string
+Reporter::DataProfileKindToString (const DataProfile::Kind &kind) const
+{
+    const char *result{""};
+    switch (kind)
+    {
+        case DataProfile::DK_CharacterSet:
+            result = "charset";
+            break;
+        case DataProfile::DK_Compressed:
+            result = "compressed";
+            break;
+        case DataProfile::DK_Fill:
+            result = "fill";
+            break;
+        case DataProfile::DK_Table:
+            result = "table";
+            break;
+        case DataProfile::DK_Text:
+            result = "text";
+            break;
+        default: assert(false);
+    }
+    return result;
+}
+
 std::string
 Reporter::SegmentTypeToString (const Segment::Type &type) const
 {
@@ -101,6 +139,30 @@ Reporter::SegmentTypeToString (const Segment::Type &type) const
     return result;
 }
 
+std::string
+Reporter::TableCandidateKindToString (const TableCandidate::Kind &kind) const
+{
+    // Named as the overlay structures declaring them:
+    const char *result{""};
+    switch (kind)
+    {
+        case TableCandidate::TK_Keyed:
+            result = "keyed_vector_tables";
+            break;
+        case TableCandidate::TK_MinusOne:
+            result = "minus_one_vector_tables";
+            break;
+        case TableCandidate::TK_Normal:
+            result = "normal_vector_tables";
+            break;
+        case TableCandidate::TK_Split:
+            result = "split_vector_tables";
+            break;
+        default: assert(false);
+    }
+    return result;
+}
+
 void
 Reporter::StreamAddress (std::ostream &ostream, const Address &address) const
 {
@@ -150,10 +212,10 @@ Reporter::StreamOctets (std::ostream &ostream, const std::vector<Octet> &octets,
 void
 Reporter::StreamInstruction (std::ostream &ostream, const Instruction &instruction, const Address &address) const
 {
-    const MnemonicInfo &mnemonicInfo{_pAnalyzer->LookupMnemonicInfo(instruction._opcodeInfo._mnemonic)};
+    const MnemonicInfo &mnemonicInfo{_pAnalyzer->LookupMnemonicInfo(instruction.GetOpcodeInfo()._mnemonic)};
     ostream << mnemonicInfo._text << ' ';
     Operand operand{instruction._operand};
-    const AddressMode &addressMode{instruction._opcodeInfo._addressMode};
+    const AddressMode &addressMode{instruction.GetOpcodeInfo()._addressMode};
     const AddressModeInfo &addressModeInfo{_pAnalyzer->LookupAddressModeInfo(addressMode)};
     ostream << addressModeInfo._operandPrefix;
 
@@ -215,6 +277,19 @@ Reporter::StreamLabel (std::ostream &ostream, const Address &address) const
     ostream.copyfmt(save);
 }
 
+// Notes the cycles of the basic block starting at address, if any, on a line of its own:
+void
+Reporter::StreamBlockCycles (std::ostream &ostream, const Address &address) const
+{
+    const auto blockIndexOpt{_pAnalyzer->FindBasicBlock(address)};
+    if (!blockIndexOpt)
+        return;
+    const BasicBlock &block{_pAnalyzer->GetBasicBlocks()[*blockIndexOpt]};
+    if (block._startAddress == address)
+        ostream << std::string(kCyclesColumn, ' ') << ";block " << AddressToString(block._startAddress) << '-' <<
+            AddressToString(block._endAddress) << ", cycles " << CycleRangeToString(block._cycles) << std::endl;
+}
+
 void
 Reporter::StreamCodeSegment (std::ostream &ostream, const Address &start, const Address &end) const
 {
@@ -223,6 +298,7 @@ Reporter::StreamCodeSegment (std::ostream &ostream, const Address &start, const
     for (; instructionItor != instructions.end() && instructionItor->first <= end; ++instructionItor)
     {
         const Address &address{instructionItor->first};
+        StreamBlockCycles(ostream, address);
         StreamAddress(ostream, address);
         const Instruction &instruction{instructionItor->second};
         std::string rawDisassembly;
@@ -230,6 +306,7 @@ Reporter::StreamCodeSegment (std::ostream &ostream, const Address &start, const
         DisassembleInstruction(address, instruction, rawDisassembly, cookedDisassembly);
 
         ostream << "  " << rawDisassembly << "  ";
+        StreamCycles(ostream, _pAnalyzer->LookupCycleRange(address, instruction));
         StreamLabel(ostream, address);
         ostream << " " << cookedDisassembly << std::endl;
     }
@@ -258,6 +335,20 @@ Reporter::StreamDataSegment (std::ostream &ostream, const Address &start, const
     ostream.copyfmt(save);
 }
 
+// A column of its own, blank for anything but an instruction:
+void
+Reporter::StreamCycles (std::ostream &ostream, const std::optional<CycleRange> &rangeOpt) const
+{
+    const size_t kCyclesWidth{4};
+
+    std::ios save(nullptr);
+    save.copyfmt(ostream);
+
+    ostream << std::left << std::setw(kCyclesWidth) << (rangeOpt ? CycleRangeToString(*rangeOpt) : "");
+
+    ostream.copyfmt(save);
+}
+
 inline void
 Reporter::StreamIllegal (std::ostream &ostream, const Opcode &opcode) const
 {
@@ -270,8 +361,11 @@ Reporter::StreamOrigin (std::ostream &ostream) const
     std::ios save(nullptr);
     save.copyfmt(ostream);
 
-    ostream << std::setw(37) << "*= $";
+    ostream << std::setw(kCyclesColumn + 25) << "*= $";
     StreamAddress(ostream, _pAnalyzer->GetOriginAddress());
+    const auto confidenceOpt{_pAnalyzer->GetOriginConfidence()};
+    if (confidenceOpt)
+        ostream << "  ;detected, confidence " << static_cast<uint16_t>(*confidenceOpt) << '%';
     ostream << std::endl;
 
     ostream.copyfmt(save);
@@ -288,7 +382,7 @@ Reporter::DisassembleInstruction (
     const auto assembly{_pAnalyzer->GetAssembly()};
     std::vector<Octet> octets;
     octets.push_back(assembly[address - originAddress]);
-    const AddressMode &addressMode{instruction._opcodeInfo._addressMode};
+    const AddressMode &addressMode{instruction.GetOpcodeInfo()._addressMode};
     const AddressModeInfo &addressModeInfo{_pAnalyzer->LookupAddressModeInfo(addressMode)};
     uint16_t index{address};
     for (int count{0}; count < addressModeInfo._operandSize; ++count)
@@ -302,6 +396,149 @@ Reporter::DisassembleInstruction (
     return sizeof(Opcode) + addressModeInfo._operandSize;
 }
 
+void
+Reporter::ReportCallGraph (std::ostream &ostream) const
+{
+    // Each subroutine is followed by its callees and the zero page cells it or they write, runs of cells as ranges:
+    static constexpr size_t kAddressesPerLine{8};
+    static constexpr size_t kIndent{22};
+
+    const auto subroutines{_pAnalyzer->GetSubroutines()};
+    const auto recursiveCount{
+        std::count_if(
+            std::begin(subroutines),
+            std::end(subroutines),
+            [] (const Subroutine &subroutine) { return subroutine._isRecursive; })};
+    uint16_t maxCallDepth{0};
+    for (const auto &subroutine: subroutines)
+        maxCallDepth = std::max(maxCallDepth, subroutine._maxCallDepth);
+
+    ostream << std::endl <<
+        "Call Graph Report" << std::endl <<
+        "-----------------" << std::endl <<
+        "Subroutines (count) : " << subroutines.size() << std::endl <<
+        "  Recursive         : " << recursiveCount << std::endl <<
+        "Components (count)  : " << _pAnalyzer->GetCallComponentCount() << std::endl <<
+        "Max call depth      : " << maxCallDepth << std::endl << std::endl;
+
+    for (size_t subroutineIndex{0}; subroutineIndex < subroutines.size(); ++subroutineIndex)
+    {
+        const auto &subroutine{subroutines[subroutineIndex]};
+        ostream << '$';
+        StreamAddress(ostream, subroutine._entryAddress);
+        ostream << ' ';
+        StreamLabel(ostream, subroutine._entryAddress);
+
+        std::string registers{"----"};
+        if (subroutine._writtenRegisters & Subroutine::R_A)
+            registers[0] = 'A';
+        if (subroutine._writtenRegisters & Subroutine::R_X)
+            registers[1] = 'X';
+        if (subroutine._writtenRegisters & Subroutine::R_Y)
+            registers[2] = 'Y';
+        if (subroutine._writtenRegisters & Subroutine::R_S)
+            registers[3] = 'S';
+        const char *returnText{"none"};
+        if (subroutine._returnsByRts)
+            returnText = subroutine._returnsByRti ? "rts+rti" : "rts";
+        else if (subroutine._returnsByRti)
+            returnText = "rti";
+        ostream <<
+            "depth:" << subroutine._maxCallDepth << ' ' <<
+            "writes:" << registers << ' ' <<
+            "returns:" << returnText <<
+            (subroutine._isRecursive ? " recursive" : "") << std::endl;
+
+        const auto callees{_pAnalyzer->GetCallees(subroutineIndex)};
+        for (size_t calleeIndex{0}; calleeIndex < callees.size(); ++calleeIndex)
+        {
+            if (calleeIndex % kAddressesPerLine == 0)
+            {
+                if (calleeIndex != 0)
+                    ostream << std::endl;
+                ostream << std::setw(kIndent) << "" << "calls:";
+            }
+            ostream << " $";
+            StreamAddress(ostream, subroutines[callees[calleeIndex]]._entryAddress);
+        }
+        if (!callees.empty())
+            ostream << std::endl;
+
+        size_t rangeCount{0};
+        for (uint32_t cell{0}; cell < subroutine._writtenZeroPage.size(); ++cell)
+        {
+            if (!subroutine._writtenZeroPage[cell])
+                continue;
+            uint32_t lastCell{cell};
+            while (lastCell + 1 < subroutine._writtenZeroPage.size() && subroutine._writtenZeroPage[lastCell + 1])
+                ++lastCell;
+            if (rangeCount % kAddressesPerLine == 0)
+            {
+                if (rangeCount != 0)
+                    ostream << std::endl;
+                ostream << std::setw(kIndent) << "" << "zero page:";
+            }
+            ostream << " $" << AddressToString(static_cast<Address>(cell)).substr(2);
+            if (lastCell != cell)
+                ostream << "-$" << AddressToString(static_cast<Address>(lastCell)).substr(2);
+            ++rangeCount;
+            cell = lastCell;
+        }
+        if (rangeCount != 0)
+            ostream << std::endl;
+    }
+}
+
+void
+Reporter::ReportCrossReferences (std::ostream &ostream) const
+{
+    // Each referenced address is followed by its referring instructions, suffixed by kind: b(ranch), c(all), j(ump),
+    // m(odify), r(ead) or w(rite):
+    static constexpr size_t kReferencesPerLine{8};
+
+    const auto addresses{_pAnalyzer->GetCrossReferencedAddresses()};
+    size_t referenceCount{0};
+    for (size_t addressIndex{0}; addressIndex < addresses.size(); ++addressIndex)
+        referenceCount += _pAnalyzer->GetCrossReferences(addressIndex).size();
+
+    ostream << std::endl <<
+        "Cross References Report" << std::endl <<
+        "-----------------------" << std::endl <<
+        "Referenced addresses (count) : " << addresses.size() << std::endl <<
+        "References (count)           : " << referenceCount << std::endl << std::endl;
+
+    for (size_t addressIndex{0}; addressIndex < addresses.size(); ++addressIndex)
+    {
+        ostream << '$';
+        StreamAddress(ostream, addresses[addressIndex]);
+        ostream << ' ';
+        StreamLabel(ostream, addresses[addressIndex]);
+
+        const auto references{_pAnalyzer->GetCrossReferences(addressIndex)};
+        for (size_t referenceIndex{0}; referenceIndex < references.size(); ++referenceIndex)
+        {
+            if (referenceIndex != 0 && referenceIndex % kReferencesPerLine == 0)
+                ostream << std::endl << std::setw(22) << "";
+            const auto &reference{references[referenceIndex]};
+            char kindCode{'?'};
+            switch (reference._kind)
+            {
+                case CrossReference::XK_Branch: kindCode = 'b'; break;
+                case CrossReference::XK_Call: kindCode = 'c'; break;
+                case CrossReference::XK_Jump: kindCode = 'j'; break;
+                case CrossReference::XK_Modify: kindCode = 'm'; break;
+                case CrossReference::XK_Read: kindCode = 'r'; break;
+                case CrossReference::XK_Write: kindCode = 'w'; break;
+                default: assert(false);
+            }
+            ostream << ' ';
+            StreamAddress(ostream, reference._address);
+            ostream << ':' << kindCode;
+        }
+        ostream << std::endl;
+    }
+}
+
 void
 Reporter::ReportDisassembly (std::ostream &ostream) const
 {
@@ -365,9 +602,16 @@ Reporter::ReportDisassembly (std::ostream &ostream) const
         "Instructions (count)  : " << instructionCount << std::endl << std::endl;
     StreamOrigin(ostream);
     ostream << std::endl;
+    auto segments{_pAnalyzer->GetSegments()};
     for (const auto &pair: rawDisassembly)
     {
         const Address &address{pair.first};
+        const auto segmentItor{segments.find(address)};
+        if (segmentItor != segments.end() && segmentItor->second.IsCode())
+            ostream << std::string(kCyclesColumn, ' ') << ";segment #" << segmentItor->second._ordinal <<
+                ", cycles " << CycleRangeToString(_pAnalyzer->CountCodeSegmentCycles(segmentItor->second)) <<
+                std::endl;
+        StreamBlockCycles(ostream, address);
         StreamAddress(ostream, address);
 
         const std::string &rawLine{pair.second};
@@ -377,6 +621,12 @@ Reporter::ReportDisassembly (std::ostream &ostream) const
         const std::string &cookedLine{cookedItor->second};
 
         ostream << "  " << rawLine << "  ";
+        const auto instructionItor{instructions.find(address)};
+        StreamCycles(
+            ostream,
+            (instructionItor == instructions.end())
+                ? std::nullopt
+                : std::optional<CycleRange>{_pAnalyzer->LookupCycleRange(address, instructionItor->second)});
         StreamLabel(ostream, address);
         ostream << " " << cookedLine << std::endl;
     }
@@ -415,6 +665,13 @@ Reporter::ReportFingerprints (std::ostream &ostream) const
         StreamAddress(str, segment._startAddress);
         str << ' ';
         StreamLabel(str, segment._startAddress);
+        const auto profileOpt{_pAnalyzer->LookupDataProfile(segment._startAddress)};
+        if (profileOpt)
+            str << std::right << std::fixed << std::setprecision(2) <<
+                DataProfileKindToString(profileOpt->_kind) << ' ' <<
+                "entropy:" << profileOpt->_entropy << ' ' <<
+                "printable:" << static_cast<uint16_t>(profileOpt->_printablePercent) << "% " <<
+                "zero:" << static_cast<uint16_t>(profileOpt->_zeroPercent) << '%';
         str << std::endl;
 
         sorted.insert(str.str());
@@ -424,6 +681,60 @@ Reporter::ReportFingerprints (std::ostream &ostream) const
         ostream << line;
 }
 
+void
+Reporter::ReportLoops (std::ostream &ostream) const
+{
+    // Counted loops give their total duration, the others that of one iteration:
+    auto streamTime{
+        [this, &ostream] (const CycleRange &cycles) -> void
+        {
+            std::ios save(nullptr);
+            save.copyfmt(ostream);
+            ostream << std::fixed << std::setprecision(2) << cycles._min / _clockMegahertz;
+            if (cycles._max != cycles._min)
+                ostream << '-' << cycles._max / _clockMegahertz;
+            ostream << "us";
+            ostream.copyfmt(save);
+        }};
+
+    const auto loops{_pAnalyzer->GetLoops()};
+    const auto countedCount{
+        std::count_if(std::begin(loops), std::end(loops), [] (const Loop &loop) { return loop._isCounted; })};
+
+    std::ios save(nullptr);
+    save.copyfmt(ostream);
+    ostream << std::endl <<
+        "Loop Timing Report" << std::endl <<
+        "------------------" << std::endl <<
+        "Clock (MHz)   : " << std::fixed << std::setprecision(6) << _clockMegahertz << std::endl <<
+        "Loops (count) : " << loops.size() << std::endl <<
+        "  Counted     : " << countedCount << std::endl << std::endl;
+    ostream.copyfmt(save);
+
+    for (const auto &loop: loops)
+    {
+        ostream << '$';
+        StreamAddress(ostream, loop._startAddress);
+        ostream << ' ';
+        StreamLabel(ostream, loop._startAddress);
+        ostream << "counter:" << ((loop._counter == Loop::LC_X) ? 'X' : 'Y') << (loop._isCountingDown ? "--" : "++");
+        if (loop._isCounted)
+        {
+            ostream << " initial:$" << AddressToString(loop._initialValue).substr(2) <<
+                " iterations:" << loop._iterationCount <<
+                " cycles:" << CycleRangeToString(loop._totalCycles) << " time:";
+            streamTime(loop._totalCycles);
+        }
+        else
+        {
+            ostream << " initial:? cycles/iteration:" << CycleRangeToString(loop._iterationCycles) <<
+                " time/iteration:";
+            streamTime(loop._iterationCycles);
+        }
+        ostream << std::endl;
+    }
+}
+
 void
 Reporter::ReportOverlays (std::ostream &ostream) const
 {
@@ -511,8 +822,24 @@ Reporter::ReportSegments (std::ostream &ostream) const
             ' ' <<
             SegmentTypeToString(segment._type) <<
             ' ' <<
-            md5.hexdigest() <<
-            std::endl;
+            md5.hexdigest();
+        const auto confidenceOpt{_pAnalyzer->LookupDarkCodeConfidence(segment._startAddress)};
+        if (confidenceOpt)
+            ostream << " ;dark code confidence " << static_cast<uint16_t>(*confidenceOpt) << '%';
+        if (segment.IsCode())
+            ostream << " ;cycles " << CycleRangeToString(_pAnalyzer->CountCodeSegmentCycles(segment));
+        const auto profileOpt{_pAnalyzer->LookupDataProfile(segment._startAddress)};
+        if (profileOpt)
+        {
+            std::ios save(nullptr);
+            save.copyfmt(ostream);
+            ostream << " ;" << DataProfileKindToString(profileOpt->_kind) <<
+                ", entropy " << std::fixed << std::setprecision(2) << profileOpt->_entropy <<
+                ", printable " << static_cast<uint16_t>(profileOpt->_printablePercent) << '%' <<
+                ", zero " << static_cast<uint16_t>(profileOpt->_zeroPercent) << '%';
+            ostream.copyfmt(save);
+        }
+        ostream << std::endl;
 
         if (segment.IsCode())
             StreamCodeSegment(ostream, segment._startAddress, segment._endAddress);
@@ -523,6 +850,168 @@ Reporter::ReportSegments (std::ostream &ostream) const
     }
 }
 
+void
+Reporter::ReportTableCandidates (std::ostream &ostream) const
+{
+    const auto candidates{_pAnalyzer->GetTableCandidates()};
+    const auto appliedCount{
+        std::count_if(
+            std::begin(candidates),
+            std::end(candidates),
+            [] (const TableCandidate &candidate) { return candidate._isApplied; })};
+
+    ostream << std::endl <<
+        "Table Candidates Report" << std::endl <<
+        "-----------------------" << std::endl <<
+        "Candidates (count) : " << candidates.size() << std::endl <<
+        "  Applied          : " << appliedCount << std::endl << std::endl;
+
+    for (const auto &candidate: candidates)
+    {
+        ostream << std::left <<
+            std::setw(23) << TableCandidateKindToString(candidate._kind) << ' ' << '$';
+        StreamAddress(ostream, candidate._address);
+        ostream << ' ' <<
+            std::setw(5) << candidate._vectorCount << ' ' <<
+            "score:" << std::setw(3) << static_cast<uint16_t>(candidate._score) <<
+            (candidate._isApplied ? " applied" : "") << std::right << ' ';
+        StreamLabel(ostream, candidate._address);
+        ostream << std::endl;
+    }
+}
+
+void
+Reporter::ReportUsage (std::ostream &ostream) const
+{
+    // Zero page is mapped a cell at a time as r(ead), w(ritten) or b(oth), in upper case if also a pointer, P if only a
+    // pointer and '.' if unused.  Used addresses beyond it and outside the object, i.e. the stack, RAM and I/O, are
+    // listed as runs:
+    static constexpr uint32_t kZeroPageSize{0x100};
+    static constexpr uint32_t kStackEndAddress{0x1FF};
+    static constexpr size_t kRangesPerLine{8};
+    static constexpr size_t kIndent{22};
+
+    const auto &readAddresses{_pAnalyzer->GetReadAddresses()};
+    const auto &writtenAddresses{_pAnalyzer->GetWrittenAddresses()};
+    const auto &pointerAddresses{_pAnalyzer->GetPointerAddresses()};
+    AddressBitmap usedAddresses{readAddresses};
+    usedAddresses.Unite(writtenAddresses);
+    usedAddresses.Unite(pointerAddresses);
+    uint32_t zeroPageCount{0};
+    for (uint32_t cell{usedAddresses.FindNext(0)}; cell < kZeroPageSize; cell = usedAddresses.FindNext(cell + 1))
+        ++zeroPageCount;
+
+    ostream << std::endl <<
+        "Usage Report" << std::endl <<
+        "------------" << std::endl <<
+        "Read (addresses)      : " << readAddresses.size() << std::endl <<
+        "Written (addresses)   : " << writtenAddresses.size() << std::endl <<
+        "Pointers (addresses)  : " << pointerAddresses.size() << std::endl <<
+        "Zero page used (cells): " << zeroPageCount << std::endl <<
+        "Zero page free (cells): " << kZeroPageSize - zeroPageCount << std::endl << std::endl;
+
+    std::ios save(nullptr);
+    save.copyfmt(ostream);
+    ostream << "     ";
+    for (uint32_t column{0}; column < 0x10; ++column)
+        ostream << ' ' << std::hex << std::uppercase << column;
+    ostream << std::endl;
+    for (uint32_t row{0}; row < kZeroPageSize; row += 0x10)
+    {
+        ostream << '$' << AddressToString(static_cast<Address>(row)).substr(2) << "  ";
+        for (uint32_t cell{row}; cell < row + 0x10; ++cell)
+        {
+            const auto address{static_cast<Address>(cell)};
+            const bool isRead{readAddresses.Contains(address)};
+            const bool isWritten{writtenAddresses.Contains(address)};
+            char code{'.'};
+            if (isRead)
+                code = isWritten ? 'b' : 'r';
+            else if (isWritten)
+                code = 'w';
+            if (pointerAddresses.Contains(address))
+                code = (code == '.') ? 'P' : static_cast<char>(std::toupper(code));
+            ostream << ' ' << code;
+        }
+        ostream << std::endl;
+    }
+    ostream.copyfmt(save);
+
+    // Streams runs of cells within [startAddress, endAddress] that are members of addresses as ranges:
+    auto streamRanges{
+        [this, &ostream] (
+            const char *title,
+            const AddressBitmap &addresses,
+            uint32_t startAddress,
+            uint32_t endAddress) -> void
+        {
+            ostream << std::endl << std::left << std::setw(kIndent) << title << std::right;
+            const size_t digitOffset{(endAddress < kZeroPageSize) ? 2u : 0u};
+            size_t rangeCount{0};
+            for (uint32_t address{addresses.FindNext(startAddress)}; address <= endAddress;
+                address = addresses.FindNext(address + 1))
+            {
+                uint32_t lastAddress{address};
+                while (lastAddress < endAddress && addresses.Contains(static_cast<Address>(lastAddress + 1)))
+                    ++lastAddress;
+                if (rangeCount != 0 && rangeCount % kRangesPerLine == 0)
+                    ostream << std::endl << std::setw(kIndent) << "";
+                ostream << " $" << AddressToString(static_cast<Address>(address)).substr(digitOffset);
+                if (lastAddress != address)
+                    ostream << "-$" << AddressToString(static_cast<Address>(lastAddress)).substr(digitOffset);
+                ++rangeCount;
+                address = lastAddress;
+            }
+            if (rangeCount == 0)
+                ostream << " none";
+            ostream << std::endl;
+        }};
+
+    AddressBitmap freeZeroPage;
+    for (uint32_t cell{0}; cell < kZeroPageSize; ++cell)
+        if (!usedAddresses.Contains(static_cast<Address>(cell)))
+            freeZeroPage.Insert(static_cast<Address>(cell));
+    streamRanges("Free zero page:", freeZeroPage, 0, kZeroPageSize - 1);
+    streamRanges("Used stack page:", usedAddresses, kZeroPageSize, kStackEndAddress);
+
+    // Runs beyond the stack page outside the object, one a line with how they are used and the first one's label:
+    ostream << std::endl << "Used outside object:" << std::endl;
+    const uint32_t originAddress{_pAnalyzer->GetOriginAddress()};
+    const uint32_t endAddress{originAddress + static_cast<uint32_t>(_pAnalyzer->GetAssemblySize()) - 1};
+    for (uint32_t address{usedAddresses.FindNext(kStackEndAddress + 1)}; address < AddressBitmap::kSize;
+        address = usedAddresses.FindNext(address + 1))
+    {
+        if (address >= originAddress && address <= endAddress)
+        {
+            address = endAddress;
+            continue;
+        }
+        uint32_t lastAddress{address};
+        bool isRead{false};
+        bool isWritten{false};
+        bool isPointer{false};
+        for (;;)
+        {
+            const auto cell{static_cast<Address>(lastAddress)};
+            isRead |= readAddresses.Contains(cell);
+            isWritten |= writtenAddresses.Contains(cell);
+            isPointer |= pointerAddresses.Contains(cell);
+            if (lastAddress + 1 >= AddressBitmap::kSize || lastAddress + 1 == originAddress ||
+                !usedAddresses.Contains(static_cast<Address>(lastAddress + 1)))
+                break;
+            ++lastAddress;
+        }
+        std::string range{'$' + AddressToString(static_cast<Address>(address))};
+        if (lastAddress != address)
+            range += "-$" + AddressToString(static_cast<Address>(lastAddress));
+        ostream << std::left << std::setw(12) << range <<
+            (isRead ? 'r' : '-') << (isWritten ? 'w' : '-') << (isPointer ? 'p' : '-') << ' ' << std::right;
+        StreamLabel(ostream, static_cast<Address>(address));
+        ostream << std::endl;
+        address = lastAddress;
+    }
+}
+
 void
 Reporter::ReportHeader (
     const std::string &timeText,
@@ -542,6 +1031,39 @@ Reporter::ReportHeader (
     }
 }
 
+void
+Reporter::SetClockRate (const std::string &clockText)
+{
+    // Atari 8-bit computers divide their color clocks down to the CPU's:
+    static const std::map<std::string, double> kNamedClockRates
+        {
+            {"ntsc", 1.7897725},
+            {"pal", 1.7734470}
+        };
+
+    const auto itor{kNamedClockRates.find(clockText)};
+    if (itor != std::end(kNamedClockRates))
+        _clockMegahertz = itor->second;
+    else
+    {
+        double megahertz{0.0};
+        size_t length{0};
+        try
+        {
+            megahertz = std::stod(clockText, &length);
+        }
+        catch (const std::exception &exc)
+        {}
+        if (length != clockText.size() || !(megahertz > 0.0 && megahertz <= 100.0))
+        {
+            std::ostringstream text;
+            text << "clock rate '" << clockText << "' must be ntsc, pal or MHz greater than 0 and at most 100";
+            throw UsageError(text.str());
+        }
+        _clockMegahertz = megahertz;
+    }
+}
+
 void
 Reporter::Report (
     std::shared_ptr<ILoader> pLoader,
@@ -562,10 +1084,20 @@ Reporter::Report (
 
             case 'f': ReportFingerprints(outStream); break;
 
+            case 'x': ReportCrossReferences(outStream); break;
+
+            case 'c': ReportCallGraph(outStream); break;
+
+            case 'u': ReportUsage(outStream); break;
+
+            case 'l': ReportLoops(outStream); break;
+
             case 'o': ReportOverlays(outStream); break;
 
             case 's': ReportSegments(outStream); break;
 
+            case 't': ReportTableCandidates(outStream); break;
+
             default: assert(false); break;
         }
 }
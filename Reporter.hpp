@@ -38,10 +38,15 @@ namespace Hac65
 
 class Reporter : public IReporter
 {
-    const std::string kAllReportFlags{"sdfo"};
+    const std::string kAllReportFlags{"sdfotxcul"};
+
+    // Where the cycles column starts on a disassembly line, after the address and octets:
+    static constexpr size_t kCyclesColumn{16};
 
     std::string _reportFlags{"s"};
 
+    double _clockMegahertz{1.0};
+
     std::shared_ptr<IAnalyzer> _pAnalyzer;
 
     std::shared_ptr<ILoader> _pLoader;
@@ -52,9 +57,18 @@ class Reporter : public IReporter
         std::optional<Opcode> opcodeOpt = std::nullopt,
         bool isSymbolic = false) const;
 
+    std::string
+    CycleRangeToString (const CycleRange &range) const;
+
+    std::string
+    DataProfileKindToString (const DataProfile::Kind &kind) const;
+
     std::string
     SegmentTypeToString (const Segment::Type &type) const;
 
+    std::string
+    TableCandidateKindToString (const TableCandidate::Kind &kind) const;
+
     size_t
     DisassembleInstruction (
         const Address &address,
@@ -62,12 +76,21 @@ class Reporter : public IReporter
         std::string &rawDisassembly,
         std::string &cookedDisassembly) const;
 
+    void
+    ReportCallGraph (std::ostream &ostream) const;
+
+    void
+    ReportCrossReferences (std::ostream &ostream) const;
+
     void
     ReportDisassembly (std::ostream &ostream) const;
 
     void
     ReportFingerprints (std::ostream &ostream) const;
 
+    void
+    ReportLoops (std::ostream &ostream) const;
+
     void
     ReportHeader (
         const std::string &timeText,
@@ -80,9 +103,18 @@ class Reporter : public IReporter
     void
     ReportSegments (std::ostream &ostream) const;
 
+    void
+    ReportTableCandidates (std::ostream &ostream) const;
+
+    void
+    ReportUsage (std::ostream &ostream) const;
+
     void
     StreamAddress (std::ostream &ostream, const Address &address) const;
 
+    void
+    StreamBlockCycles (std::ostream &ostream, const Address &address) const;
+
     void
     StreamCodeSegment (std::ostream &stream, const Address &start, const Address &end) const;
 
@@ -92,6 +124,9 @@ class Reporter : public IReporter
     void
     StreamDataSegment (std::ostream &stream, const Address &start, const Address &end) const;
 
+    void
+    StreamCycles (std::ostream &ostream, const std::optional<CycleRange> &rangeOpt) const;
+
     void
     StreamIllegal (std::ostream &ostream, const Opcode &opcode) const;
 
@@ -116,6 +151,9 @@ public:
         const std::string &commandText,
         std::ostream &outStream) override;
 
+    void
+    SetClockRate (const std::string &clockText) override;
+
     void
     SetReportFlags (std::string reportFlags) override
     {
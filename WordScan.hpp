@@ -0,0 +1,85 @@
+//
+// HAC/65 6502 Inferencing Disassembler
+//
+// This work is licensed under the MIT License <https://opensource.org/licenses/MIT>
+// Copyright 2018 David Hinson <https://github.com/dhinson919>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Portions of this work are derived from the RSA Data Security, Inc. MD5 Message-Digest Algorithm
+//
+
+#ifndef HAC65_WORDSCAN_HPP
+#define HAC65_WORDSCAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "common.hpp"
+
+namespace Hac65
+{
+
+// Flags each of count offsets from pOctets (1 if so, else 0) whose little-endian word, taking its low octet from that
+// offset and its high octet from highOffset further on, lies within [lowWord, highWord].  With SSE2 sixteen offsets
+// are tested at once and only the remainder one at a time.  Octets through offset count - 1 + highOffset are read:
+inline void
+FlagWordsInRange (
+    const Octet *pOctets,
+    size_t count,
+    size_t highOffset,
+    uint16_t lowWord,
+    uint16_t highWord,
+    Octet *pFlags)
+{
+    size_t offset{0};
+
+#if defined(__SSE2__)
+    // SSE2 only compares signed words, so bias everything by the sign bit to compare unsigned:
+    const __m128i bias{_mm_set1_epi16(static_cast<short>(0x8000))};
+    const __m128i lowWords{_mm_xor_si128(_mm_set1_epi16(static_cast<short>(lowWord)), bias)};
+    const __m128i highWords{_mm_xor_si128(_mm_set1_epi16(static_cast<short>(highWord)), bias)};
+    const __m128i ones{_mm_set1_epi8(1)};
+    const auto isOutOfRange{
+        [&bias, &lowWords, &highWords] (__m128i words) -> __m128i
+        {
+            words = _mm_xor_si128(words, bias);
+            return _mm_or_si128(_mm_cmplt_epi16(words, lowWords), _mm_cmpgt_epi16(words, highWords));
+        }};
+    for (; offset + 16 <= count; offset += 16)
+    {
+        const __m128i lows{_mm_loadu_si128(reinterpret_cast<const __m128i *>(pOctets + offset))};
+        const __m128i highs{_mm_loadu_si128(reinterpret_cast<const __m128i *>(pOctets + offset + highOffset))};
+        const __m128i outOfRange{
+            _mm_packs_epi16(
+                isOutOfRange(_mm_unpacklo_epi8(lows, highs)),
+                isOutOfRange(_mm_unpackhi_epi8(lows, highs)))};
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pFlags + offset), _mm_andnot_si128(outOfRange, ones));
+    }
+#endif
+
+    for (; offset < count; ++offset)
+    {
+        const auto word{static_cast<uint16_t>(pOctets[offset] | (pOctets[offset + highOffset] << 8))};
+        pFlags[offset] = (lowWord <= word && word <= highWord) ? 1 : 0;
+    }
+}
+
+}
+
+#endif //HAC65_WORDSCAN_HPP
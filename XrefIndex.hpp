@@ -0,0 +1,115 @@
+//
+// HAC/65 6502 Inferencing Disassembler
+//
+// This work is licensed under the MIT License <https://opensource.org/licenses/MIT>
+// Copyright 2018 David Hinson <https://github.com/dhinson919>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Portions of this work are derived from the RSA Data Security, Inc. MD5 Message-Digest Algorithm
+//
+
+#ifndef HAC65_XREFINDEX_HPP
+#define HAC65_XREFINDEX_HPP
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "common.hpp"
+
+namespace Hac65
+{
+
+// Cross references by referenced address in compressed sparse row form.  Referenced addresses are ordered; those of
+// the one at index n occupy [_referenceOffsets[n], _referenceOffsets[n + 1]) of _references, in the order added.
+class XrefIndex
+{
+    std::vector<Address> _targets;
+
+    std::vector<uint32_t> _referenceOffsets;
+
+    std::vector<CrossReference> _references;
+
+public:
+    // Replaces the index with the { target, reference } pairs given, bucketing them by target in two counting passes:
+    void
+    Build (const std::vector<std::pair<Address, CrossReference>> &pairs)
+    {
+        std::vector<uint32_t> counts(0x10000 + 1);
+        for (const auto &pair: pairs)
+            ++counts[pair.first + 1];
+
+        _targets.clear();
+        _referenceOffsets.clear();
+        for (uint32_t target{0}; target < 0x10000; ++target)
+        {
+            if (counts[target + 1] != 0)
+            {
+                _targets.push_back(static_cast<Address>(target));
+                _referenceOffsets.push_back(counts[target]);
+            }
+            counts[target + 1] += counts[target];
+        }
+        _referenceOffsets.push_back(static_cast<uint32_t>(pairs.size()));
+
+        _references.resize(pairs.size());
+        for (const auto &pair: pairs)
+            _references[counts[pair.first]++] = pair.second;
+    }
+
+    void
+    Clear ()
+    {
+        _targets.clear();
+        _referenceOffsets.clear();
+        _references.clear();
+    }
+
+    // Finds the index of target, if referenced:
+    std::optional<size_t>
+    FindTarget (const Address &target) const
+    {
+        std::optional<size_t> resultOpt;
+        auto itor{std::lower_bound(std::begin(_targets), std::end(_targets), target)};
+        if (itor != std::end(_targets) && *itor == target)
+            resultOpt = static_cast<size_t>(itor - std::begin(_targets));
+        return resultOpt;
+    }
+
+    Span<CrossReference>
+    GetReferences (size_t targetIndex) const
+    {
+        assert(targetIndex < _targets.size());
+        const auto offset{_referenceOffsets[targetIndex]};
+        return {_references.data() + offset, _referenceOffsets[targetIndex + 1] - offset};
+    }
+
+    size_t
+    GetReferenceCount () const
+    {
+        return _references.size();
+    }
+
+    Span<Address>
+    GetTargets () const
+    {
+        return {_targets.data(), _targets.size()};
+    }
+};
+
+}
+
+#endif //HAC65_XREFINDEX_HPP
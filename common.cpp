@@ -35,13 +35,21 @@ const char *kUsageText
         "  -S <digits>      Starting position within object\n"
         "  -E <digits>      Ending position within object\n"
         "  -A <aro-name>    Top architecture overlay\n"
-        "  -o <digits>      Origin address\n"
-        "  -i               Illuminate dark code\n"
-        "  -R [sfdo]        Reporting options\n"
+        "  -o <digits>|auto Origin address, or auto to detect\n"
+        "  -i[digits]       Illuminate dark code at confidence (default 50)\n"
+        "  -j <digits>      Inference jobs (default 1)\n"
+        "  -a <digits>      Apply table candidates scoring at least digits\n"
+        "  -R [sfdotxcul]   Reporting options\n"
         "                     s = segments\n"
         "                     f = segment fingerprints\n"
         "                     d = disassembly\n"
         "                     o = overlays\n"
+        "                     t = table candidates\n"
+        "                     x = cross references\n"
+        "                     c = call graph\n"
+        "                     u = address usage\n"
+        "                     l = loop timing\n"
+        "  -c <clock>       CPU MHz for loop timing, or ntsc or pal (default 1)\n"
     };
 
 const char *kVersionText{"HAC/65 v0.5 6502 Inferencing Disassembler"};
@@ -23,9 +23,12 @@
 #ifndef HAC65_COMMON_HPP
 #define HAC65_COMMON_HPP
 
+#include <bitset>
 #include <cassert>
+#include <cstddef>
 #include <regex>
 #include <string>
+#include <utility>
 
 namespace Hac65
 {
@@ -51,7 +54,7 @@ enum Mnemonic
 
 struct MnemonicInfo
 {
-    const std::string _text;
+    const char *_text;
 };
 
 enum AddressMode
@@ -97,11 +100,14 @@ struct OpcodeInfo
     MemoryOperation _memoryOperation;
 };
 
+// An instruction packed into four octets; its opcode info is looked up in the decode table:
 struct Instruction
 {
     Opcode _opcode;
-    OpcodeInfo _opcodeInfo;
     Operand _operand;
+
+    const OpcodeInfo &
+    GetOpcodeInfo () const;
 };
 
 struct Segment
@@ -134,6 +140,278 @@ struct Segment
     }
 };
 
+// Read-only view of a contiguous run of values owned elsewhere:
+template <typename Value>
+class Span
+{
+    const Value *_pValues{nullptr};
+    size_t _size{0};
+
+public:
+    Span () = default;
+
+    Span (const Value *pValues, size_t size) : _pValues(pValues), _size(size)
+    {}
+
+    const Value &
+    operator[] (size_t index) const
+    {
+        assert(index < _size);
+        return _pValues[index];
+    }
+
+    const Value *
+    begin () const
+    {
+        return _pValues;
+    }
+
+    const Value *
+    data () const
+    {
+        return _pValues;
+    }
+
+    bool
+    empty () const
+    {
+        return _size == 0;
+    }
+
+    const Value *
+    end () const
+    {
+        return _pValues + _size;
+    }
+
+    size_t
+    size () const
+    {
+        return _size;
+    }
+};
+
+// Fewest and most cycles taken by an instruction, or by a run of instructions each executed once:
+struct CycleRange
+{
+    uint32_t _min;
+    uint32_t _max;
+
+    CycleRange &
+    operator+= (const CycleRange &other)
+    {
+        _min += other._min;
+        _max += other._max;
+        return *this;
+    }
+};
+
+struct BasicBlock
+{
+    Address _startAddress;
+    Address _endAddress;
+    CycleRange _cycles;
+};
+
+struct FlowEdge
+{
+    enum Kind : Octet
+    {
+        EK__Unknown,
+        EK_FallThrough,
+        EK_Branch,
+        EK_Jump,
+        EK_Call,
+        EK_Return   // From a calling block to where its callee returns
+    };
+
+    // The block at the other end of the edge:
+    uint32_t _blockIndex;
+    Kind _kind;
+};
+
+// A subroutine entered by JSR, summarized together with everything it calls.  Subroutines calling each other in a
+// cycle share a component; components are numbered callees first:
+struct Subroutine
+{
+    enum Register : Octet
+    {
+        R__Unknown = 0,
+        R_A = 0x01,
+        R_X = 0x02,
+        R_Y = 0x04,
+        R_S = 0x08
+    };
+
+    Address _entryAddress;
+    uint32_t _componentIndex;
+
+    // Longest chain of calls out of its component, a component counting once:
+    uint16_t _maxCallDepth;
+
+    // Written by it or its callees:
+    Octet _writtenRegisters;
+    std::bitset<0x100> _writtenZeroPage;
+
+    bool _isRecursive;
+    bool _returnsByRti;
+    bool _returnsByRts;
+};
+
+// A loop closed by a BNE branching back to its start, counted to zero by X or Y, or by a BPL, counted down past zero.
+// Its iterations are known if the counter is loaded with the same constant on every way in:
+struct Loop
+{
+    enum Counter : Octet
+    {
+        LC__Unknown,
+        LC_X,
+        LC_Y
+    };
+
+    Address _startAddress;
+    Address _endAddress;
+    Counter _counter;
+    bool _isCountingDown;
+
+    bool _isCounted;
+    Octet _initialValue;
+    uint16_t _iterationCount;
+
+    // One pass branching back to the start:
+    CycleRange _iterationCycles;
+
+    // Every pass, the last falling through; zero unless counted:
+    CycleRange _totalCycles;
+};
+
+// A reference to an address by an instruction's operand, indexed operands referring to their base address:
+struct CrossReference
+{
+    enum Kind : Octet
+    {
+        XK__Unknown,
+        XK_Branch,
+        XK_Call,
+        XK_Jump,
+        XK_Modify,  // Both read and written, as by INC or ROL
+        XK_Read,
+        XK_Write
+    };
+
+    // The referring instruction:
+    Address _address;
+    Kind _kind;
+};
+
+// Layout of the entries of a declared table.  Each entry spans entrySize octets holding the low octet of a vector at
+// vectorOffset and its high octet at highOffset, except that split tables hold the high octets in a second run of
+// entries following the first.  Vectors, plus landAdjust, land on code.  An indirect table's vectors instead locate
+// single vectors landing on code, adjusted by landAdjust, and a jump table's entries are JMP instructions:
+struct TableLayout
+{
+    enum Role : Octet
+    {
+        TR__Unknown,
+        TR_Indirect,
+        TR_Jump,
+        TR_Vector
+    };
+
+    Role _role;
+    uint8_t _entrySize;
+    uint8_t _vectorOffset;
+    uint8_t _highOffset;
+    bool _isSplit;
+    uint8_t _landAdjust;
+
+    uint32_t
+    GetTableSize (uint16_t vectorCount) const
+    {
+        return static_cast<uint32_t>(vectorCount) * _entrySize * (_isSplit ? 2u : 1u);
+    }
+
+    // Offsets of the low and high octets of the vector at index from the start of a table of vectorCount:
+    std::pair<uint32_t, uint32_t>
+    GetVectorOffsets (uint16_t vectorCount, uint16_t index) const
+    {
+        const uint32_t entryOffset{static_cast<uint32_t>(index) * _entrySize};
+        const uint32_t highRunOffset{_isSplit ? static_cast<uint32_t>(vectorCount) * _entrySize : 0u};
+        return {entryOffset + _vectorOffset, highRunOffset + entryOffset + _highOffset};
+    }
+};
+
+// The layouts declarable by name in overlays' structures, as { <entry octets> }:
+
+// { IL, IH }
+inline constexpr TableLayout kNormalTableLayout{TableLayout::TR_Vector, 2, 0, 1, false, 0};
+
+// { VL -> IL, VH -> VH }
+inline constexpr TableLayout kIndirectTableLayout{TableLayout::TR_Indirect, 2, 0, 1, false, 0};
+
+// { <key>, IL, IH }
+inline constexpr TableLayout kKeyedTableLayout{TableLayout::TR_Vector, 3, 1, 2, false, 0};
+
+// { <key>, VL -> IL, VH -> VH }
+inline constexpr TableLayout kKeyedIndirectTableLayout{TableLayout::TR_Indirect, 3, 1, 2, false, 0};
+
+// { <key>, VL -> (IL-1), VH -> IH }
+inline constexpr TableLayout kKeyedIndirectMinusOneTableLayout{TableLayout::TR_Indirect, 3, 1, 2, false, 1};
+
+// { JMP, IL, IH }
+inline constexpr TableLayout kJumpTableLayout{TableLayout::TR_Jump, 3, 1, 2, false, 0};
+
+// { (IL-1), IH }
+inline constexpr TableLayout kMinusOneTableLayout{TableLayout::TR_Vector, 2, 0, 1, false, 1};
+
+// { IL, +count:IH }
+inline constexpr TableLayout kSplitTableLayout{TableLayout::TR_Vector, 1, 0, 0, true, 0};
+
+// A run of inferred data resembling a vector table, its vectors landing on instructions:
+struct TableCandidate
+{
+    enum Kind : Octet
+    {
+        TK__Unknown,
+        TK_Keyed,
+        TK_MinusOne,
+        TK_Normal,
+        TK_Split
+    };
+
+    Address _address;
+    uint16_t _vectorCount;
+    Kind _kind;
+
+    // Out of 100, rising with the number of vectors and how surely they land on code:
+    uint8_t _score;
+
+    // Whether the candidate was declared as a table during inference:
+    bool _isApplied;
+};
+
+// Statistics of an inferred data segment's octets and the kind of data they suggest:
+struct DataProfile
+{
+    enum Kind : Octet
+    {
+        DK__Unknown,
+        DK_CharacterSet,
+        DK_Compressed,
+        DK_Fill,
+        DK_Table,
+        DK_Text
+    };
+
+    Kind _kind;
+
+    // Shannon entropy in bits per octet:
+    float _entropy;
+
+    uint8_t _printablePercent;
+    uint8_t _zeroPercent;
+};
+
 extern const char *kUsageText;
 
 extern const char *kVersionText;
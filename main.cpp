@@ -55,7 +55,7 @@ main (int argc, char *argv[])
     try
     {
         int opt{};
-        while ((opt = ::getopt(argc, argv, "hvS:E:A:o:iR:")) != -1)
+        while ((opt = ::getopt(argc, argv, "hvS:E:A:o:i::j:a:R:c:")) != -1)
         {
             switch (opt)
             {
@@ -80,15 +80,38 @@ main (int argc, char *argv[])
 
                 // Analyzer options:
                 case 'o':
+                    if (std::string(::optarg) == "auto")
+                        pAnalyzer->SetOriginDetectingMode();
+                    else
                     {
                         uint16_t value{ParseDigitsArg("-o arg contains ")};
                         pAnalyzer->DeclareOriginAddress(value);
                     }
                     break;
-                case 'i': pAnalyzer->SetIlluminatingMode(); break;
+                case 'i':
+                    pAnalyzer->SetIlluminatingMode();
+                    if (::optarg != nullptr)
+                    {
+                        uint16_t value{ParseDigitsArg("-i arg contains ")};
+                        pAnalyzer->SetIlluminatingThreshold(value);
+                    }
+                    break;
+                case 'j':
+                    {
+                        uint16_t value{ParseDigitsArg("-j arg contains ")};
+                        pAnalyzer->SetJobCount(value);
+                    }
+                    break;
+                case 'a':
+                    {
+                        uint16_t value{ParseDigitsArg("-a arg contains ")};
+                        pAnalyzer->SetTableApplyingScore(value);
+                    }
+                    break;
 
                 // Reporter options:
                 case 'R': pReporter->SetReportFlags(::optarg); break;
+                case 'c': pReporter->SetClockRate(::optarg); break;
 
                 default: throw UsageError(kUsageText);
             }
@@ -0,0 +1,250 @@
+//
+// HAC/65 6502 Inferencing Disassembler
+//
+// This work is licensed under the MIT License <https://opensource.org/licenses/MIT>
+// Copyright 2018 David Hinson <https://github.com/dhinson919>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+// Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Portions of this work are derived from the RSA Data Security, Inc. MD5 Message-Digest Algorithm
+//
+
+
+// Reproduces the log-odds tables of DarkCodeModel.hpp.  Run from the top of the tree, where the overlays and rom/ are:
+//
+//   dark-code-trainer segments > tools/DarkCodeCorpus.txt
+//   dark-code-trainer tables < tools/DarkCodeCorpus.txt
+//
+// "segments" analyzes each object of the corpus without illuminating and lists its code and data segments; "tables"
+// tallies the opcode classes of a listed segment set and prints the tables in the layout DarkCodeModel.hpp uses.
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <vector>
+
+#include "../DarkCodeModel.hpp"
+#include "../IHac65.hpp"
+using namespace Hac65;
+
+static const char *kTrainerUsageText{"Usage: dark-code-trainer segments|tables"};
+
+// { architecture overlay, object filename }:
+static const std::pair<const char *, const char *> kCorpus[]
+    {
+        {"Atari1050RevKAnno", "rom/1050-revK.rom"},
+        {"Atari800OSA", "rom/800antsc.rom"},
+        {"Atari1050RevKAnno", "rom/1050-FLOPOS.rom"},
+        {"Atari800OSA", "rom/800apal.rom"}
+    };
+
+static const char *kOpcodeClassNames[kOpcodeClassCount]
+    {
+        "Illegal", "Load", "Store", "Arithmetic", "Compare", "Modify", "Branch", "Jump", "Return", "Transfer", "Flag",
+        "Break"
+    };
+
+// Occurrences of each opcode class first on its own, then after one class, then after two:
+struct Tally
+{
+    size_t _unigrams[kOpcodeClassCount]{};
+    size_t _bigrams[kOpcodeClassCount][kOpcodeClassCount]{};
+    size_t _trigrams[kOpcodeClassCount][kOpcodeClassCount][kOpcodeClassCount]{};
+};
+
+static void
+WriteSegments (std::ostream &ostream)
+{
+    IHac65 &hac65{GetHac65()};
+    ostream << "# Code and data segments of the dark code corpus, as listed by 'dark-code-trainer segments'\n";
+    ostream << std::uppercase << std::hex << std::setfill('0');
+    for (const auto &[pArchitecture, pObjectFilename]: kCorpus)
+    {
+        auto pAnalyzer{hac65.MakeAnalyzer()};
+        auto pLoader{hac65.MakeLoader()};
+        pLoader->SetArchitecture(pArchitecture);
+        pLoader->SetObjectFilename(pObjectFilename);
+        pLoader->Load(pAnalyzer);
+        pAnalyzer->Analyze();
+        ostream << "object " << pObjectFilename << " $" << std::setw(4) << pAnalyzer->GetOriginAddress() << '\n';
+        for (const auto &[address, segment]: pAnalyzer->GetSegments())
+        {
+            const char *pKind{nullptr};
+            if (segment._type == Segment::ST_CodeKnown || segment._type == Segment::ST_CodeInferred)
+                pKind = "code";
+            else if (segment.IsData() && segment._endAddress - segment._startAddress > 1)
+                pKind = "data";
+            if (pKind != nullptr)
+                ostream << pKind << " $" << std::setw(4) << segment._startAddress << " $" << std::setw(4)
+                    << segment._endAddress << '\n';
+        }
+    }
+}
+
+// Opcode classes of the instructions decoded linearly from one address through another, at most a count of them:
+static std::vector<OpcodeClass>
+DecodeClasses (const std::vector<Octet> &assembly, Address originAddress, Address startAddress, Address endAddress,
+    size_t maxCount)
+{
+    std::vector<OpcodeClass> result;
+    for (uint32_t address{startAddress}; address <= endAddress && result.size() < maxCount;)
+    {
+        const size_t offset{address - originAddress};
+        if (offset >= assembly.size())
+            throw Hac65Exception("segment lies outside its object");
+        const Opcode opcode{assembly[offset]};
+        result.push_back(LookupOpcodeClass(opcode));
+        address += sizeof(Opcode) + LookupDecodeEntry(opcode)._operandSize;
+    }
+    return result;
+}
+
+static void
+ReadSegments (std::istream &istream, Tally &codeTally, Tally &dataTally)
+{
+    std::vector<Octet> assembly;
+    Address originAddress{};
+    std::string line;
+    while (std::getline(istream, line))
+    {
+        std::istringstream fields{line};
+        std::string kind, first, second;
+        fields >> kind >> first >> second;
+        if (kind.empty() || kind[0] == '#')
+            continue;
+        if (kind == "object")
+        {
+            std::ifstream object{first, std::ios::binary};
+            if (!object)
+                throw Hac65Exception("cannot open object file: '" + first + '\'');
+            assembly.assign(std::istreambuf_iterator<char>{object}, std::istreambuf_iterator<char>{});
+            originAddress = FlexIntToUint16(second);
+        }
+        else if (kind == "code")
+        {
+            const auto classes{DecodeClasses(assembly, originAddress, FlexIntToUint16(first), FlexIntToUint16(second),
+                SIZE_MAX)};
+            if (classes.size() > 0)
+                ++codeTally._unigrams[classes[0]];
+            if (classes.size() > 1)
+                ++codeTally._bigrams[classes[0]][classes[1]];
+            for (size_t index{2}; index < classes.size(); ++index)
+                ++codeTally._trigrams[classes[index - 2]][classes[index - 1]][classes[index]];
+        }
+        else if (kind == "data")
+        {
+            // Dark code may start anywhere in data, so the data are decoded from every offset:
+            const Address endAddress{FlexIntToUint16(second)};
+            for (uint32_t address{FlexIntToUint16(first)}; address <= endAddress; ++address)
+            {
+                const auto classes{DecodeClasses(assembly, originAddress, static_cast<Address>(address), endAddress, 3)};
+                ++dataTally._unigrams[classes[0]];
+                if (classes.size() > 1)
+                    ++dataTally._bigrams[classes[0]][classes[1]];
+                if (classes.size() > 2)
+                    ++dataTally._trigrams[classes[0]][classes[1]][classes[2]];
+            }
+        }
+        else
+            throw Hac65Exception("unrecognized corpus line: '" + line + '\'');
+    }
+}
+
+// One row of log-odds, in quarter nats and with add-one smoothing, of each class following in code rather than data:
+static std::string
+FormatLogOddsRow (const size_t (&codeCounts)[kOpcodeClassCount], const size_t (&dataCounts)[kOpcodeClassCount])
+{
+    const size_t codeTotal{std::accumulate(std::begin(codeCounts), std::end(codeCounts), size_t{})};
+    const size_t dataTotal{std::accumulate(std::begin(dataCounts), std::end(dataCounts), size_t{})};
+    std::ostringstream result;
+    for (size_t index{}; index < kOpcodeClassCount; ++index)
+    {
+        const double codeOdds{(codeCounts[index] + 1.0) / (codeTotal + kOpcodeClassCount)};
+        const double dataOdds{(dataCounts[index] + 1.0) / (dataTotal + kOpcodeClassCount)};
+        const double logOdds{std::clamp(std::nearbyint(4 * std::log(codeOdds / dataOdds)), -127.0, 127.0)};
+        result << (index == 0 ? "" : ", ") << std::setw(4) << static_cast<int>(logOdds);
+    }
+    return result.str();
+}
+
+static void
+WriteTables (const Tally &codeTally, const Tally &dataTally, std::ostream &ostream)
+{
+    ostream << "inline constexpr int8_t kUnigramLogOdds[kOpcodeClassCount]\n    {\n";
+    ostream << "        " << FormatLogOddsRow(codeTally._unigrams, dataTally._unigrams) << "\n    };\n\n";
+
+    ostream << "inline constexpr int8_t kBigramLogOdds[kOpcodeClassCount][kOpcodeClassCount]\n    {\n";
+    for (size_t first{}; first < kOpcodeClassCount; ++first)
+        ostream << "        {" << FormatLogOddsRow(codeTally._bigrams[first], dataTally._bigrams[first]) << '}'
+            << (first + 1 < kOpcodeClassCount ? "," : " ") << "  // After " << kOpcodeClassNames[first] << '\n';
+    ostream << "    };\n\n";
+
+    ostream << "inline constexpr int8_t kTrigramLogOdds[kOpcodeClassCount][kOpcodeClassCount][kOpcodeClassCount]\n";
+    ostream << "    {\n";
+    for (size_t first{}; first < kOpcodeClassCount; ++first)
+    {
+        ostream << "        {   // After " << kOpcodeClassNames[first] << ", then:\n";
+        for (size_t second{}; second < kOpcodeClassCount; ++second)
+            ostream << "            {"
+                << FormatLogOddsRow(codeTally._trigrams[first][second], dataTally._trigrams[first][second]) << '}'
+                << (second + 1 < kOpcodeClassCount ? "," : " ") << "  // " << kOpcodeClassNames[second] << '\n';
+        ostream << "        }" << (first + 1 < kOpcodeClassCount ? "," : "") << '\n';
+    }
+    ostream << "    };\n";
+}
+
+int
+main (int argc, char *argv[])
+{
+    try
+    {
+        if (argc != 2)
+            throw UsageError(kTrainerUsageText);
+        if (::strcmp(argv[1], "segments") == 0)
+            WriteSegments(std::cout);
+        else if (::strcmp(argv[1], "tables") == 0)
+        {
+            Tally codeTally, dataTally;
+            ReadSegments(std::cin, codeTally, dataTally);
+            WriteTables(codeTally, dataTally, std::cout);
+        }
+        else
+            throw UsageError(kTrainerUsageText);
+    }
+    catch (const Hac65Exception &exc)
+    {
+        const char *what{exc.what()};
+        if (what != nullptr)
+        {
+            if (exc._exitCode != 0)
+                std::cerr << "Error: ";
+            std::cerr << what << std::endl;
+        }
+        ::exit(exc._exitCode);
+    }
+    catch (const std::exception &exc)
+    {
+        const char *what{exc.what()};
+        if (what != nullptr)
+            std::cerr << "Unusual Error: " << what << std::endl;
+        ::exit(1);
+    }
+
+    return 0;
+}